@@ -30,6 +30,7 @@
 # include <sstream>
 # include <exception>
 # include <ios>
+# include <iomanip>
 # if defined(FC_OS_LINUX) || defined(FC_OS_MACOSX) || defined(FC_OS_BSD)
 # include <unistd.h>
 # include <pwd.h>
@@ -75,6 +76,7 @@
 #include <Base/PlacementPy.h>
 #include <Base/RotationPy.h>
 #include <Base/Sequencer.h>
+#include <Base/TimeInfo.h>
 #include <Base/Tools.h>
 #include <Base/Translate.h>
 #include <Base/UnitsApi.h>
@@ -693,6 +695,8 @@ std::vector<Document*> Application::openDocuments(const std::vector<std::string>
     if (filenames.empty())
         return res;
 
+    initPendingModules();
+
     if (errs)
         errs->resize(filenames.size());
 
@@ -1263,6 +1267,7 @@ void Application::changeImportModule(const char* Type, const char* OldModuleName
 
 std::vector<std::string> Application::getImportModules(const char* Type) const
 {
+    initPendingModules();
     std::vector<std::string> modules;
     for (std::vector<FileTypeItem>::const_iterator it = _mImportTypes.begin(); it != _mImportTypes.end(); ++it) {
         const std::vector<std::string>& types = it->types;
@@ -1281,6 +1286,7 @@ std::vector<std::string> Application::getImportModules(const char* Type) const
 
 std::vector<std::string> Application::getImportModules() const
 {
+    initPendingModules();
     std::vector<std::string> modules;
     for (std::vector<FileTypeItem>::const_iterator it = _mImportTypes.begin(); it != _mImportTypes.end(); ++it)
         modules.push_back(it->module);
@@ -1291,6 +1297,7 @@ std::vector<std::string> Application::getImportModules() const
 
 std::vector<std::string> Application::getImportTypes(const char* Module) const
 {
+    initPendingModules();
     std::vector<std::string> types;
     for (std::vector<FileTypeItem>::const_iterator it = _mImportTypes.begin(); it != _mImportTypes.end(); ++it) {
 #ifdef __GNUC__
@@ -1306,6 +1313,7 @@ std::vector<std::string> Application::getImportTypes(const char* Module) const
 
 std::vector<std::string> Application::getImportTypes(void) const
 {
+    initPendingModules();
     std::vector<std::string> types;
     for (std::vector<FileTypeItem>::const_iterator it = _mImportTypes.begin(); it != _mImportTypes.end(); ++it) {
         types.insert(types.end(), it->types.begin(), it->types.end());
@@ -1319,6 +1327,7 @@ std::vector<std::string> Application::getImportTypes(void) const
 
 std::map<std::string, std::string> Application::getImportFilters(const char* Type) const
 {
+    initPendingModules();
     std::map<std::string, std::string> moduleFilter;
     for (std::vector<FileTypeItem>::const_iterator it = _mImportTypes.begin(); it != _mImportTypes.end(); ++it) {
         const std::vector<std::string>& types = it->types;
@@ -1337,6 +1346,7 @@ std::map<std::string, std::string> Application::getImportFilters(const char* Typ
 
 std::map<std::string, std::string> Application::getImportFilters(void) const
 {
+    initPendingModules();
     std::map<std::string, std::string> filter;
     for (std::vector<FileTypeItem>::const_iterator it = _mImportTypes.begin(); it != _mImportTypes.end(); ++it) {
         filter[it->filter] = it->module;
@@ -1386,6 +1396,7 @@ void Application::changeExportModule(const char* Type, const char* OldModuleName
 
 std::vector<std::string> Application::getExportModules(const char* Type) const
 {
+    initPendingModules();
     std::vector<std::string> modules;
     for (std::vector<FileTypeItem>::const_iterator it = _mExportTypes.begin(); it != _mExportTypes.end(); ++it) {
         const std::vector<std::string>& types = it->types;
@@ -1404,6 +1415,7 @@ std::vector<std::string> Application::getExportModules(const char* Type) const
 
 std::vector<std::string> Application::getExportModules() const
 {
+    initPendingModules();
     std::vector<std::string> modules;
     for (std::vector<FileTypeItem>::const_iterator it = _mExportTypes.begin(); it != _mExportTypes.end(); ++it)
         modules.push_back(it->module);
@@ -1414,6 +1426,7 @@ std::vector<std::string> Application::getExportModules() const
 
 std::vector<std::string> Application::getExportTypes(const char* Module) const
 {
+    initPendingModules();
     std::vector<std::string> types;
     for (std::vector<FileTypeItem>::const_iterator it = _mExportTypes.begin(); it != _mExportTypes.end(); ++it) {
 #ifdef __GNUC__
@@ -1429,6 +1442,7 @@ std::vector<std::string> Application::getExportTypes(const char* Module) const
 
 std::vector<std::string> Application::getExportTypes(void) const
 {
+    initPendingModules();
     std::vector<std::string> types;
     for (std::vector<FileTypeItem>::const_iterator it = _mExportTypes.begin(); it != _mExportTypes.end(); ++it) {
         types.insert(types.end(), it->types.begin(), it->types.end());
@@ -1442,6 +1456,7 @@ std::vector<std::string> Application::getExportTypes(void) const
 
 std::map<std::string, std::string> Application::getExportFilters(const char* Type) const
 {
+    initPendingModules();
     std::map<std::string, std::string> moduleFilter;
     for (std::vector<FileTypeItem>::const_iterator it = _mExportTypes.begin(); it != _mExportTypes.end(); ++it) {
         const std::vector<std::string>& types = it->types;
@@ -1460,6 +1475,7 @@ std::map<std::string, std::string> Application::getExportFilters(const char* Typ
 
 std::map<std::string, std::string> Application::getExportFilters(void) const
 {
+    initPendingModules();
     std::map<std::string, std::string> filter;
     for (std::vector<FileTypeItem>::const_iterator it = _mExportTypes.begin(); it != _mExportTypes.end(); ++it) {
         filter[it->filter] = it->module;
@@ -1580,6 +1596,8 @@ Application * Application::_pcSingleton = 0;
 
 int Application::_argc;
 char ** Application::_argv;
+std::vector<std::pair<std::string, double> > Application::_startupTimes;
+bool Application::_pendingModuleInit = false;
 
 
 void Application::destruct(void)
@@ -1794,7 +1812,9 @@ void Application::init(int argc, char ** argv)
 #if defined(FC_SE_TRANSLATOR)
         _set_se_translator(my_se_translator_filter);
 #endif
+        Base::TimeInfo start;
         initTypes();
+        addStartupTime("Init types", Base::TimeInfo::diffTimeF(start));
 
 #if (BOOST_FILESYSTEM_VERSION == 2)
         boost::filesystem::path::default_name_check(boost::filesystem::no_check);
@@ -1802,6 +1822,10 @@ void Application::init(int argc, char ** argv)
 
         initConfig(argc,argv);
         initApplication();
+        addStartupTime("Total", Base::TimeInfo::diffTimeF(start));
+
+        if (mConfig["StartupProfile"] == "1")
+            printStartupTimes();
     }
     catch (...) {
         // force the log to flush
@@ -1810,6 +1834,44 @@ void Application::init(int argc, char ** argv)
     }
 }
 
+void Application::addStartupTime(const char *name, double seconds)
+{
+    _startupTimes.emplace_back(name, seconds);
+}
+
+const std::vector<std::pair<std::string, double> > &Application::getStartupTimes()
+{
+    return _startupTimes;
+}
+
+void Application::printStartupTimes(void)
+{
+    std::stringstream str;
+    str << "Startup profile:" << std::endl;
+    for (const auto &v : _startupTimes) {
+        str << "  " << std::left << std::setw(48) << v.first
+            << std::right << std::setw(10) << std::fixed << std::setprecision(1)
+            << v.second * 1000.0 << " ms" << std::endl;
+    }
+    Console().Message("%s", str.str().c_str());
+}
+
+void Application::initPendingModules()
+{
+    if (!_pendingModuleInit)
+        return;
+    _pendingModuleInit = false;
+
+    Base::TimeInfo start;
+    try {
+        Interpreter().runString("import FreeCAD\nFreeCAD.__initPendingModules__()");
+    }
+    catch (const Base::Exception& e) {
+        e.ReportException();
+    }
+    FC_LOG("Deferred module initialization took " << Base::TimeInfo::diffTimeF(start) << " s");
+}
+
 void Application::initTypes(void)
 {
     // Base types
@@ -2080,11 +2142,13 @@ void Application::initConfig(int argc, char ** argv)
     PyImport_AppendInittab ("FreeCAD", init_freecad_module);
     PyImport_AppendInittab ("__FreeCADBase__", init_freecad_base_module);
 #endif
+    Base::TimeInfo start;
     const char* pythonpath = Interpreter().init(argc,argv);
     if (pythonpath)
         mConfig["PythonSearchPath"] = pythonpath;
     else
         Base::Console().Warning("Encoding of Python paths failed\n");
+    addStartupTime("Init Python", Base::TimeInfo::diffTimeF(start));
 
     // Parse the options that have impact on the init process
     ParseOptions(argc,argv);
@@ -2124,7 +2188,9 @@ void Application::initConfig(int argc, char ** argv)
                               mConfig["BuildVersionMinor"].c_str(),
                               mConfig["BuildRevision"].c_str());
     }
+    start.setCurrent();
     LoadParameters();
+    addStartupTime("Load parameters", Base::TimeInfo::diffTimeF(start));
 
     auto loglevelParam = _pcUserParamMngr->GetGroup("BaseApp/LogLevels");
     const auto &loglevels = loglevelParam->GetIntMap();
@@ -2228,6 +2294,7 @@ void Application::initApplication(void)
 
     // starting the init script
     Console().Log("Run App init script\n");
+    Base::TimeInfo start;
     try {
         Interpreter().runString(Base::ScriptFactory().ProduceScript("CMakeVariables"));
         Interpreter().runString(Base::ScriptFactory().ProduceScript("FreeCADInit"));
@@ -2235,6 +2302,11 @@ void Application::initApplication(void)
     catch (const Base::Exception& e) {
         e.ReportException();
     }
+    addStartupTime("App init script", Base::TimeInfo::diffTimeF(start));
+
+    // the init script has deferred the module initialization
+    if (mConfig["LazyModuleInit"] == "1")
+        _pendingModuleInit = true;
 
     // seed randomizer
     srand(time(0));
@@ -2593,6 +2665,8 @@ void Application::ParseOptions(int ac, char ** av)
     ("module-path,M", value< vector<string> >()->composing(),"Additional module paths")
     ("python-path,P", value< vector<string> >()->composing(),"Additional python paths")
     ("single-instance", "Allow to run a single instance of the application")
+    ("startup-profile", "Prints the time spent in each startup phase and module initialization")
+    ("lazy-init", "Defers running the Init.py of the modules until they are needed")
     ;
 
 
@@ -2816,6 +2890,14 @@ void Application::ParseOptions(int ac, char ** av)
         mConfig["SingleInstance"] = "1";
     }
 
+    if (vm.count("startup-profile")) {
+        mConfig["StartupProfile"] = "1";
+    }
+
+    if (vm.count("lazy-init")) {
+        mConfig["LazyModuleInit"] = "1";
+    }
+
     if (vm.count("dump-config")) {
         std::stringstream str;
         for (std::map<std::string,std::string>::iterator it=mConfig.begin(); it != mConfig.end(); ++it) {
@@ -394,6 +394,21 @@ public:
     static char** GetARGV(void){return _argv;}
     //@}
 
+    /** @name Startup profiling and lazy module initialization */
+    //@{
+    /// Record the time in seconds spent in a startup phase or module initialization
+    static void addStartupTime(const char *name, double seconds);
+    /// Return the recorded startup phases in the order they were finished
+    static const std::vector<std::pair<std::string, double> > &getStartupTimes();
+    /** Run the module Init.py scripts deferred by the lazy init mode
+     *
+     * With the --lazy-init command line option the Init.py scripts of the
+     * modules are not executed at startup but only when the file type
+     * registry is queried or a document is opened for the first time.
+     */
+    static void initPendingModules();
+    //@}
+
     /** @name Application directories */
     //@{
     const char* getHomePath(void) const;
@@ -547,6 +562,9 @@ private:
     static PyObject *sDumpSWIG(PyObject *self,PyObject *args);
 
     static PyObject *sCheckAbort(PyObject *self,PyObject *args);
+
+    static PyObject *sGetStartupTimes(PyObject *self,PyObject *args);
+    static PyObject *sAddStartupTime (PyObject *self,PyObject *args);
     static PyMethodDef    Methods[];
 
     friend class ApplicationObserver;
@@ -575,10 +593,16 @@ private:
     static void LoadParameters(void);
     /// puts the given env variable in the config
     static void SaveEnv(const char *);
+    /// print the startup phases recorded so far
+    static void printStartupTimes(void);
     /// startup configuration container
     static std::map<std::string,std::string> mConfig;
     static int _argc;
     static char ** _argv;
+    /// recorded startup phases
+    static std::vector<std::pair<std::string, double> > _startupTimes;
+    /// module Init.py scripts are waiting to be run
+    static bool _pendingModuleInit;
     //@}
 
     struct FileTypeItem {
@@ -187,6 +187,14 @@ PyMethodDef Application::Methods[] = {
      "There is an active sequencer during document restore and recomputation. User may\n"
      "abort the operation by pressing the ESC key. Once detected, this function will\n"
      "trigger a BaseExceptionFreeCADAbort exception."},
+    {"getStartupTimes", (PyCFunction) Application::sGetStartupTimes, METH_VARARGS,
+     "getStartupTimes() -> list\n\n"
+     "Return a list of (name, seconds) tuples of the recorded startup phases and\n"
+     "module initializations. Use the --startup-profile command line option to\n"
+     "print them when the application has been initialized."},
+    {"addStartupTime", (PyCFunction) Application::sAddStartupTime, METH_VARARGS,
+     "addStartupTime(name, seconds) -> None\n\n"
+     "Record the time spent in a startup phase."},
     {NULL, NULL, 0, NULL}		/* Sentinel */
 };
 
@@ -968,6 +976,35 @@ PyObject *Application::sCheckAbort(PyObject * /*self*/, PyObject *args)
     }PY_CATCH
 }
 
+PyObject *Application::sGetStartupTimes(PyObject * /*self*/, PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+
+    PY_TRY {
+        const auto &times = getStartupTimes();
+        Py::List list;
+        for (const auto &v : times) {
+            Py::Tuple tuple(2);
+            tuple.setItem(0, Py::String(v.first));
+            tuple.setItem(1, Py::Float(v.second));
+            list.append(tuple);
+        }
+        return Py::new_reference_to(list);
+    }PY_CATCH
+}
+
+PyObject *Application::sAddStartupTime(PyObject * /*self*/, PyObject *args)
+{
+    char *name;
+    double seconds;
+    if (!PyArg_ParseTuple(args, "sd", &name, &seconds))
+        return 0;
+
+    addStartupTime(name, seconds);
+    Py_Return;
+}
+
 PyObject *Application::sDumpSWIG(PyObject * /*self*/, PyObject *args)
 {
     if (!PyArg_ParseTuple(args, ""))
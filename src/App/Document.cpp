@@ -2938,10 +2938,15 @@ void Document::restore (const char *filename,
     std::unique_ptr<zipios::ZipInputStream> zipstream;
     std::string dirname;
 
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Document");
+    Base::XMLReader::ParserType parserType = hGrp->GetBool("InSituXMLParser", false)
+            ? Base::XMLReader::InSituParser : Base::XMLReader::XercesParser;
+
     if(fi.fileNamePure() == "Document" && fi.hasExtension("xml")) {
         Base::FileInfo di(fi.dirPath());
         _reader.reset(new Base::FileReader(fi,di.fileName()+"/Document.xml"));
-        _xmlReader.reset(new Base::XMLReader(*_reader));
+        _xmlReader.reset(new Base::XMLReader(*_reader, 16*1024, parserType));
     } else {
         // file.open(fi, std::ios::in | std::ios::binary);
         // std::streambuf* buf = file.rdbuf();
@@ -2951,7 +2956,7 @@ void Document::restore (const char *filename,
         //     throw Base::FileException("Invalid project file",filename);
         zipstream.reset(new zipios::ZipInputStream(filename));
         _reader.reset(new Base::ZipReader(*zipstream,filename));
-        _xmlReader.reset(new Base::XMLReader(*_reader));
+        _xmlReader.reset(new Base::XMLReader(*_reader, 16*1024, parserType));
     }
 
     restore(*_xmlReader, delaySignal, objNames);
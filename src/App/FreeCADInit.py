@@ -81,6 +81,36 @@ def setupSearchPaths(PathExtension):
 FreeCAD._importFromFreeCAD = removeFromPath
 
 
+def InitModule(Dir, InstallFile):
+	"""runs the Init.py of a module and records the time it takes"""
+	start = time.time()
+	try:
+		# XXX: This looks scary securitywise...
+
+		with open(InstallFile) as f:
+			exec(f.read())
+	except Exception as inst:
+		Log('Init:      Initializing ' + Dir + '... failed\n')
+		Log('-'*100+'\n')
+		Log(traceback.format_exc())
+		Log('-'*100+'\n')
+		Err('During initialization the error "' + str(inst) + '" occurred in ' + InstallFile + '\n')
+		Err('Please look into the log file for further information\n')
+	else:
+		Log('Init:      Initializing ' + Dir + '... done\n')
+	FreeCAD.addStartupTime('Init module ' + os.path.basename(Dir), time.time() - start)
+
+def InitPendingModules():
+	"""runs the Init.py of the modules deferred by the lazy init mode"""
+	pending = FreeCAD.__PendingModuleInit__
+	FreeCAD.__PendingModuleInit__ = []
+	for Dir, InstallFile in pending:
+		InitModule(Dir, InstallFile)
+
+FreeCAD.__PendingModuleInit__ = []
+FreeCAD.__initPendingModules__ = InitPendingModules
+
+
 def InitApplications():
 	# Checking on FreeCAD module path ++++++++++++++++++++++++++++++++++++++++++
 	ModDir = FreeCAD.getHomePath()+'Mod'
@@ -163,26 +193,21 @@ def InitApplications():
 	# proper python modules this can eventuelly be removed.
 	sys.path = [ModDir] + libpaths + [ExtDir] + sys.path
 
+	# with --lazy-init the Init.py scripts are run on first use of the
+	# file type registry or when opening a document
+	LazyInit = FreeCAD.ConfigGet("LazyModuleInit") == "1"
+
 	for Dir in ModDict.values():
 		if ((Dir != '') & (Dir != 'CVS') & (Dir != '__init__.py')):
 			sys.path.insert(0,Dir)
 			PathExtension.append(Dir)
 			InstallFile = os.path.join(Dir,"Init.py")
 			if (os.path.exists(InstallFile)):
-				try:
-					# XXX: This looks scary securitywise...
-
-					with open(InstallFile) as f:
-						exec(f.read())
-				except Exception as inst:
-					Log('Init:      Initializing ' + Dir + '... failed\n')
-					Log('-'*100+'\n')
-					Log(traceback.format_exc())
-					Log('-'*100+'\n')
-					Err('During initialization the error "' + str(inst) + '" occurred in ' + InstallFile + '\n')
-					Err('Please look into the log file for further information\n')
+				if LazyInit:
+					Log('Init:      Initializing ' + Dir + '... deferred\n')
+					FreeCAD.__PendingModuleInit__.append((Dir, InstallFile))
 				else:
-					Log('Init:      Initializing ' + Dir + '... done\n')
+					InitModule(Dir, InstallFile)
 			else:
 				Log('Init:      Initializing ' + Dir + '(Init.py not found)... ignore\n')
 
@@ -195,6 +220,7 @@ def InitApplications():
 		for _, freecad_module_name, freecad_module_ispkg in pkgutil.iter_modules(freecad.__path__, "freecad."):
 			if freecad_module_ispkg:
 				Log('Init: Initializing ' + freecad_module_name + '\n')
+				start = time.time()
 				try:
 					freecad_module = importlib.import_module(freecad_module_name)
 					extension_modules += [freecad_module_name]
@@ -212,6 +238,7 @@ def InitApplications():
 					Log('-'*80+'\n')
 					Log(traceback.format_exc())
 					Log('-'*80+'\n')
+				FreeCAD.addStartupTime('Init ' + freecad_module_name, time.time() - start)
 	except ImportError as inst:
 		Err('During initialization the error "' + str(inst) + '" occurred\n')
 
@@ -249,7 +276,7 @@ App.__unit_test__ = []
 Log ('Init: starting App::FreeCADInit.py\n')
 
 try:
-    import sys,os,traceback,io,inspect
+    import sys,os,traceback,io,inspect,time
     from datetime import datetime
 except ImportError:
     FreeCAD.Console.PrintError("\n\nSeems the python standard libs are not installed, bailing out!\n\n")
@@ -61,6 +61,7 @@
 
 // Streams
 #include <iostream>
+#include <iomanip>
 #include <sstream>
 
 // STL
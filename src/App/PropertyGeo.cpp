@@ -368,20 +368,25 @@ void PropertyVectorList::restoreXML(Base::XMLReader &reader)
     setValues(std::move(values));
 }
 
+// The bulk stream functions below rely on vectors being stored as plain coordinate triples
+static_assert(sizeof(Base::Vector3d) == 3*sizeof(double), "Unexpected layout of Base::Vector3d");
+static_assert(sizeof(Base::Vector3f) == 3*sizeof(float), "Unexpected layout of Base::Vector3f");
+
 void PropertyVectorList::saveStream(Base::OutputStream &str) const
 {
     if (!isSinglePrecision()) {
-        for (std::vector<Base::Vector3d>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            str << it->x << it->y << it->z;
-        }
+        if (!_lValueList.empty())
+            str.write(&_lValueList[0].x, 3*_lValueList.size());
     }
     else {
+        std::vector<float> coords;
+        coords.reserve(3*_lValueList.size());
         for (std::vector<Base::Vector3d>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            float x = (float)it->x;
-            float y = (float)it->y;
-            float z = (float)it->z;
-            str << x << y << z;
+            coords.push_back((float)it->x);
+            coords.push_back((float)it->y);
+            coords.push_back((float)it->z);
         }
+        str.write(coords.data(), coords.size());
     }
 }
 
@@ -389,16 +394,14 @@ void PropertyVectorList::restoreStream(Base::InputStream &str, unsigned uCt)
 {
     std::vector<Base::Vector3d> values(uCt);
     if (!isSinglePrecision()) {
-        for (std::vector<Base::Vector3d>::iterator it = values.begin(); it != values.end(); ++it) {
-            str >> it->x >> it->y >> it->z;
-        }
+        if (uCt)
+            str.read(&values[0].x, 3*std::size_t(uCt));
     }
     else {
-        float x,y,z;
-        for (std::vector<Base::Vector3d>::iterator it = values.begin(); it != values.end(); ++it) {
-            str >> x >> y >> z;
-            it->Set(x, y, z);
-        }
+        std::vector<float> coords(3*std::size_t(uCt));
+        str.read(coords.data(), coords.size());
+        for (unsigned i=0; i<uCt; ++i)
+            values[i].Set(coords[3*i], coords[3*i+1], coords[3*i+2]);
     }
     setValues(std::move(values));
 }
@@ -465,15 +468,15 @@ void _PropertyVectorList::restoreXML(Base::XMLReader &reader)
 
 void _PropertyVectorList::saveStream(Base::OutputStream &str) const
 {
-    for(const auto &v : _lValueList)
-        str << v.x << v.y << v.z;
+    if(!_lValueList.empty())
+        str.write(&_lValueList[0].x, 3*_lValueList.size());
 }
 
 void _PropertyVectorList::restoreStream(Base::InputStream &str, unsigned uCt)
 {
     std::vector<Base::Vector3f> values(uCt);
-    for(auto &v : _lValueList)
-        str >> v.x >> v.y >> v.z;
+    if(uCt)
+        str.read(&values[0].x, 3*std::size_t(uCt));
     setValues(std::move(values));
 }
 
@@ -1480,15 +1480,11 @@ void PropertyFloatList::restoreXML(Base::XMLReader &reader)
 void PropertyFloatList::saveStream(Base::OutputStream &str) const
 {
     if (!isSinglePrecision()) {
-        for (std::vector<double>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            str << *it;
-        }
+        str.write(_lValueList.data(), _lValueList.size());
     }
     else {
-        for (std::vector<double>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            float v = (float)*it;
-            str << v;
-        }
+        std::vector<float> values(_lValueList.begin(), _lValueList.end());
+        str.write(values.data(), values.size());
     }
 }
 
@@ -1496,16 +1492,12 @@ void PropertyFloatList::restoreStream(Base::InputStream &str, unsigned uCt)
 {
     std::vector<double> values(uCt);
     if (!isSinglePrecision()) {
-        for (std::vector<double>::iterator it = values.begin(); it != values.end(); ++it) {
-            str >> *it;
-        }
+        str.read(values.data(), uCt);
     }
     else {
-        for (std::vector<double>::iterator it = values.begin(); it != values.end(); ++it) {
-            float val;
-            str >> val;
-            (*it) = val;
-        }
+        std::vector<float> tmp(uCt);
+        str.read(tmp.data(), uCt);
+        std::copy(tmp.begin(), tmp.end(), values.begin());
     }
     setValues(std::move(values));
 }
@@ -1570,15 +1562,13 @@ void _PropertyFloatList::restoreXML(Base::XMLReader &reader)
 }
 
 void _PropertyFloatList::saveStream(Base::OutputStream &str) const {
-    for (auto &v : _lValueList)
-        str << v;
+    str.write(_lValueList.data(), _lValueList.size());
 }
 
 void _PropertyFloatList::restoreStream(Base::InputStream &str, unsigned uCt)
 {
     std::vector<float> values(uCt);
-    for(auto &v : values)
-        str >> v;
+    str.read(values.data(), uCt);
     setValues(std::move(values));
 }
 
@@ -2817,18 +2807,21 @@ void PropertyColorList::restoreXML(Base::XMLReader &reader)
 
 void PropertyColorList::saveStream(Base::OutputStream &str) const
 {
+    std::vector<uint32_t> packed; // must be 32 bit long
+    packed.reserve(_lValueList.size());
     for (std::vector<App::Color>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-        str << it->getPackedValue();
+        packed.push_back(it->getPackedValue());
     }
+    str.write(packed.data(), packed.size());
 }
 
 void PropertyColorList::restoreStream(Base::InputStream &str, unsigned uCt)
 {
+    std::vector<uint32_t> packed(uCt); // must be 32 bit long
+    str.read(packed.data(), uCt);
     std::vector<Color> values(uCt);
-    uint32_t value; // must be 32 bit long
-    for (std::vector<App::Color>::iterator it = values.begin(); it != values.end(); ++it) {
-        str >> value;
-        it->setPackedValue(value);
+    for (unsigned i=0; i<uCt; ++i) {
+        values[i].setPackedValue(packed[i]);
     }
     setValues(std::move(values));
 }
@@ -457,15 +457,11 @@ bool ParameterGrp::HasGroup(const char* Name) const
 
 bool ParameterGrp::GetBool(const char* Name, bool bPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCBool",Name);
-    // if not return preset
-    if (!pcElem) return bPreset;
-    // if yes check the value and return
-    if (strcmp(StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),"1"))
-        return false;
-    else
-        return true;
+    CachedValue value;
+    // if not in group return preset
+    if (!GetCachedValue(BoolValue, Name, value))
+        return bPreset;
+    return value.boolValue;
 }
 
 void  ParameterGrp::SetBool(const char* Name, bool bValue)
@@ -475,6 +471,7 @@ void  ParameterGrp::SetBool(const char* Name, bool bValue)
     if (pcElem) {
         // and set the value
         pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(bValue?"1":"0").unicodeForm());
+        InvalidateCachedValue(BoolValue, Name);
         // trigger observer
         Notify(Name);
     }
@@ -526,12 +523,11 @@ std::vector<std::pair<std::string,bool> > ParameterGrp::GetBoolMap(const char *
 
 long ParameterGrp::GetInt(const char* Name, long lPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCInt",Name);
-    // if not return preset
-    if (!pcElem) return lPreset;
-    // if yes check the value and return
-    return atol (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str());
+    CachedValue value;
+    // if not in group return preset
+    if (!GetCachedValue(IntValue, Name, value))
+        return lPreset;
+    return value.intValue;
 }
 
 void  ParameterGrp::SetInt(const char* Name, long lValue)
@@ -543,6 +539,7 @@ void  ParameterGrp::SetInt(const char* Name, long lValue)
         // and set the value
         sprintf(cBuf,"%li",lValue);
         pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+        InvalidateCachedValue(IntValue, Name);
         // trigger observer
         Notify(Name);
     }
@@ -589,12 +586,11 @@ std::vector<std::pair<std::string,long> > ParameterGrp::GetIntMap(const char * s
 
 unsigned long ParameterGrp::GetUnsigned(const char* Name, unsigned long lPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCUInt",Name);
-    // if not return preset
-    if (!pcElem) return lPreset;
-    // if yes check the value and return
-    return strtoul (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),0,10);
+    CachedValue value;
+    // if not in group return preset
+    if (!GetCachedValue(UnsignedValue, Name, value))
+        return lPreset;
+    return value.unsignedValue;
 }
 
 void  ParameterGrp::SetUnsigned(const char* Name, unsigned long lValue)
@@ -606,6 +602,7 @@ void  ParameterGrp::SetUnsigned(const char* Name, unsigned long lValue)
         // and set the value
         sprintf(cBuf,"%lu",lValue);
         pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+        InvalidateCachedValue(UnsignedValue, Name);
         // trigger observer
         Notify(Name);
     }
@@ -652,12 +649,11 @@ std::vector<std::pair<std::string,unsigned long> > ParameterGrp::GetUnsignedMap(
 
 double ParameterGrp::GetFloat(const char* Name, double dPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCFloat",Name);
-    // if not return preset
-    if (!pcElem) return dPreset;
-    // if yes check the value and return
-    return atof (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str());
+    CachedValue value;
+    // if not in group return preset
+    if (!GetCachedValue(FloatValue, Name, value))
+        return dPreset;
+    return value.floatValue;
 }
 
 void  ParameterGrp::SetFloat(const char* Name, double dValue)
@@ -669,6 +665,7 @@ void  ParameterGrp::SetFloat(const char* Name, double dValue)
         // and set the value
         sprintf(cBuf,"%.12f",dValue); // use %.12f instead of %f to handle values < 1.0e-6
         pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+        InvalidateCachedValue(FloatValue, Name);
         // trigger observer
         Notify(Name);
     }
@@ -742,6 +739,7 @@ void  ParameterGrp::SetASCII(const char* Name, const char *sValue)
         else {
             pcElem2->setNodeValue(XUTF8Str(sValue).unicodeForm());
         }
+        InvalidateCachedValue(TextValue, Name);
         // trigger observer
         Notify(Name);
     }
@@ -749,24 +747,15 @@ void  ParameterGrp::SetASCII(const char* Name, const char *sValue)
 
 std::string ParameterGrp::GetASCII(const char* Name, const char * pPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCText",Name);
-    // if not return preset
-    if (!pcElem) {
+    CachedValue value;
+    // if not in group or without text return preset
+    if (!GetCachedValue(TextValue, Name, value)) {
         if (pPreset==0)
             return std::string("");
         else
             return std::string(pPreset);
     }
-    // if yes check the value and return
-    DOMNode *pcElem2 = pcElem->getFirstChild();
-    if (pcElem2)
-        return std::string(StrXUTF8(pcElem2->getNodeValue()).c_str());
-    else if (pPreset==0)
-        return std::string("");
-
-    else
-        return std::string(pPreset);
+    return value.textValue;
 }
 
 std::vector<std::string> ParameterGrp::GetASCIIs(const char * sFilter) const
@@ -827,6 +816,8 @@ void ParameterGrp::RemoveASCII(const char* Name)
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
 
+    InvalidateCachedValue(TextValue, Name);
+
     // trigger observer
     Notify(Name);
 }
@@ -842,6 +833,8 @@ void ParameterGrp::RemoveBool(const char* Name)
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
 
+    InvalidateCachedValue(BoolValue, Name);
+
     // trigger observer
     Notify(Name);
 }
@@ -870,6 +863,8 @@ void ParameterGrp::RemoveFloat(const char* Name)
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
 
+    InvalidateCachedValue(FloatValue, Name);
+
     // trigger observer
     Notify(Name);
 }
@@ -885,6 +880,8 @@ void ParameterGrp::RemoveInt(const char* Name)
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
 
+    InvalidateCachedValue(IntValue, Name);
+
     // trigger observer
     Notify(Name);
 }
@@ -900,6 +897,8 @@ void ParameterGrp::RemoveUnsigned(const char* Name)
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
 
+    InvalidateCachedValue(UnsignedValue, Name);
+
     // trigger observer
     Notify(Name);
 }
@@ -995,6 +994,8 @@ void ParameterGrp::Clear(void)
         child->release();
     }
 
+    ClearCachedValues();
+
     // trigger observer
     Notify("");
 }
@@ -1085,6 +1086,69 @@ XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *ParameterGrp::FindOrCreateElement(XER
     return pcElem;
 }
 
+bool ParameterGrp::GetCachedValue(ValueType Type, const char* Name, CachedValue& Value) const
+{
+    static const char* TypeNames[NumValueTypes] = {
+        "FCBool", "FCInt", "FCUInt", "FCFloat", "FCText"
+    };
+
+    std::lock_guard<std::mutex> lock(_CacheMutex);
+    auto& cache = _ValueCache[Type];
+    auto it = cache.find(Name);
+    if (it != cache.end()) {
+        Value = it->second;
+        return Value.exists;
+    }
+
+    CachedValue value;
+    DOMElement *pcElem = FindElement(_pGroupNode, TypeNames[Type], Name);
+    if (pcElem) {
+        value.exists = true;
+        switch (Type) {
+        case BoolValue:
+            value.boolValue = strcmp(StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),"1") == 0;
+            break;
+        case IntValue:
+            value.intValue = atol(StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str());
+            break;
+        case UnsignedValue:
+            value.unsignedValue = strtoul(StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),0,10);
+            break;
+        case FloatValue:
+            value.floatValue = atof(StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str());
+            break;
+        case TextValue: {
+            // a text element without text counts as not set
+            DOMNode *pcElem2 = pcElem->getFirstChild();
+            if (pcElem2)
+                value.textValue = StrXUTF8(pcElem2->getNodeValue()).c_str();
+            else
+                value.exists = false;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    cache.emplace(Name, value);
+    Value = value;
+    return Value.exists;
+}
+
+void ParameterGrp::InvalidateCachedValue(ValueType Type, const char* Name)
+{
+    std::lock_guard<std::mutex> lock(_CacheMutex);
+    _ValueCache[Type].erase(Name);
+}
+
+void ParameterGrp::ClearCachedValues()
+{
+    std::lock_guard<std::mutex> lock(_CacheMutex);
+    for (int i=0; i<NumValueTypes; i++)
+        _ValueCache[i].clear();
+}
+
 void ParameterGrp::NotifyAll()
 {
     // get all ints and notify
@@ -1390,6 +1454,7 @@ int ParameterManager::LoadDocument(const XERCES_CPP_NAMESPACE_QUALIFIER InputSou
         throw XMLBaseException("Malformed Parameter document: Root group not found");
 
     _pGroupNode = FindElement(rootElem,"FCParamGroup","Root");
+    ClearCachedValues();
 
     if (!_pGroupNode)
         throw XMLBaseException("Malformed Parameter document: Root group not found");
@@ -1569,6 +1634,7 @@ void  ParameterManager::CreateDocument(void)
     _pGroupNode = _pDocument->createElement(XStr("FCParamGroup").unicodeForm());
     static_cast<DOMElement*>(_pGroupNode)->setAttribute(XStr("Name").unicodeForm(), XStr("Root").unicodeForm());
     rootElem->appendChild(_pGroupNode);
+    ClearCachedValues();
 }
 
 void  ParameterManager::CheckDocument() const
@@ -58,6 +58,9 @@
 #endif
 
 #include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <xercesc/util/XercesDefs.hpp>
 
@@ -265,6 +268,29 @@ protected:
      */
     XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *FindOrCreateElement(XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *Start, const char* Type, const char* Name) const;
 
+    /** @name value cache
+     *  Values are read from the DOM only once and then kept in their native form.
+     *  Every method that modifies a value must invalidate its cache entry.
+     */
+    //@{
+    enum ValueType {
+        BoolValue, IntValue, UnsignedValue, FloatValue, TextValue, NumValueTypes
+    };
+    struct CachedValue {
+        bool exists = false;
+        bool boolValue = false;
+        long intValue = 0;
+        unsigned long unsignedValue = 0;
+        double floatValue = 0.0;
+        std::string textValue;
+    };
+    /** Gets the value of the element of \a Type with the name \a Name either from the
+     *  cache or from the DOM. Returns false if there is no such value.
+     */
+    bool GetCachedValue(ValueType Type, const char* Name, CachedValue& Value) const;
+    void InvalidateCachedValue(ValueType Type, const char* Name);
+    void ClearCachedValues();
+    //@}
 
     /// DOM Node of the Base node of this group
     XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *_pGroupNode;
@@ -272,6 +298,10 @@ protected:
     std::string _cName;
     /// map of already exported groups
     std::map <std::string ,Base::Reference<ParameterGrp> > _GroupMap;
+    /// cached values of each type
+    mutable std::unordered_map<std::string, CachedValue> _ValueCache[NumValueTypes];
+    /// guards the value cache
+    mutable std::mutex _CacheMutex;
 
 };
 
@@ -28,8 +28,10 @@
 # include <xercesc/sax/SAXException.hpp>
 # include <xercesc/sax2/XMLReaderFactory.hpp>
 # include <xercesc/sax2/SAX2XMLReader.hpp>
+# include <xercesc/framework/MemBufInputSource.hpp>
 #endif
 
+#include <cstring>
 #include <locale>
 
 #include <boost/ref.hpp>
@@ -96,33 +98,400 @@ ReaderContext::~ReaderContext()
         _ReaderContext.resize(size);
 }
 
+// ---------------------------------------------------------------------------
+//  Base::XMLReader: In-situ parser
+// ---------------------------------------------------------------------------
+
+namespace {
+
+enum NormalizeMode {
+    NormalizeText,
+    NormalizeAttribute,
+    NormalizeCData
+};
+
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+inline bool isNameEnd(char c)
+{
+    return isSpace(c) || c == '/' || c == '>' || c == '=' || c == 0;
+}
+
+char *encodeUTF8(unsigned long cp, char *out)
+{
+    if (cp < 0x80) {
+        *out++ = static_cast<char>(cp);
+    }
+    else if (cp < 0x800) {
+        *out++ = static_cast<char>(0xC0 | (cp >> 6));
+        *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else if (cp < 0x10000) {
+        *out++ = static_cast<char>(0xE0 | (cp >> 12));
+        *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else {
+        *out++ = static_cast<char>(0xF0 | (cp >> 18));
+        *out++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    return out;
+}
+
+/* Normalizes line ends, resolves entity and character references (except
+ * for CDATA) and replaces white spaces in attribute values, as demanded by
+ * the XML specification. The decoded content is never longer than the
+ * source, so it is written in place. Returns the new end of the range or
+ * null on an invalid reference.
+ */
+char *normalizeInSitu(char *begin, char *end, NormalizeMode mode)
+{
+    char *out = begin;
+    for (char *p = begin; p < end;) {
+        char c = *p;
+        if (c == '&' && mode != NormalizeCData) {
+            char *semi = static_cast<char*>(std::memchr(p, ';', end - p));
+            if (!semi)
+                return nullptr;
+            ++p;
+            std::size_t len = semi - p;
+            if (len > 1 && *p == '#') {
+                char *stop;
+                unsigned long cp;
+                if (p[1] == 'x')
+                    cp = std::strtoul(p + 2, &stop, 16);
+                else
+                    cp = std::strtoul(p + 1, &stop, 10);
+                if (stop != semi || cp == 0 || cp > 0x10FFFF)
+                    return nullptr;
+                out = encodeUTF8(cp, out);
+            }
+            else if (len == 2 && std::strncmp(p, "lt", 2) == 0)
+                *out++ = '<';
+            else if (len == 2 && std::strncmp(p, "gt", 2) == 0)
+                *out++ = '>';
+            else if (len == 3 && std::strncmp(p, "amp", 3) == 0)
+                *out++ = '&';
+            else if (len == 4 && std::strncmp(p, "quot", 4) == 0)
+                *out++ = '"';
+            else if (len == 4 && std::strncmp(p, "apos", 4) == 0)
+                *out++ = '\'';
+            else
+                return nullptr;
+            p = semi + 1;
+        }
+        else if (c == '\r') {
+            *out++ = mode == NormalizeAttribute ? ' ' : '\n';
+            if (++p < end && *p == '\n')
+                ++p;
+        }
+        else {
+            if (mode == NormalizeAttribute && (c == '\t' || c == '\n'))
+                c = ' ';
+            *out++ = c;
+            ++p;
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+/* Tokenizer of the in-situ parser. It works directly on the null terminated
+ * document buffer of the XMLReader, which it modifies while parsing: element
+ * names and attribute values are null terminated and decoded in place, so
+ * they can be handed out as plain pointers without any allocation.
+ */
+struct Base::XMLReader::InSituData
+{
+    enum Event {
+        Start,
+        StartEnd,
+        End,
+        Text,
+        Finish
+    };
+
+    InSituData(std::vector<char> &buffer)
+        : pos(buffer.data()), begin(buffer.data()), end(buffer.data() + buffer.size() - 1)
+    {
+    }
+
+    /// Skip the XML declaration and misc markup until the root element
+    bool prolog()
+    {
+        const unsigned char *bom = reinterpret_cast<const unsigned char*>(pos);
+        if (end - pos >= 2 && ((bom[0] == 0xFE && bom[1] == 0xFF) || (bom[0] == 0xFF && bom[1] == 0xFE)))
+            return false; // UTF-16
+        if (end - pos >= 3 && bom[0] == 0xEF && bom[1] == 0xBB && bom[2] == 0xBF)
+            pos += 3;
+
+        if (std::strncmp(pos, "<?xml", 5) == 0 && isSpace(pos[5])) {
+            char *declEnd = std::strstr(pos, "?>");
+            if (!declEnd)
+                return false;
+            std::string decl(pos, declEnd);
+            std::size_t enc = decl.find("encoding");
+            if (enc != std::string::npos) {
+                enc = decl.find_first_of("\"'", enc);
+                if (enc == std::string::npos)
+                    return false;
+                std::size_t encEnd = decl.find(decl[enc], enc + 1);
+                if (encEnd == std::string::npos)
+                    return false;
+                std::string encoding = decl.substr(enc + 1, encEnd - enc - 1);
+                if (!boost::iequals(encoding, "UTF-8") && !boost::iequals(encoding, "UTF8")
+                        && !boost::iequals(encoding, "US-ASCII") && !boost::iequals(encoding, "ASCII"))
+                    return false;
+            }
+            pos += decl.size() + 2;
+        }
+
+        for (;;) {
+            while (isSpace(*pos))
+                ++pos;
+            if (*pos != '<' || std::strncmp(pos, "<!DOCTYPE", 9) == 0)
+                return false;
+            if (!skipMarkup())
+                return true;
+        }
+    }
+
+    /// Scan the next token
+    Event next()
+    {
+        for (;;) {
+            if (*pos != '<') {
+                if (stack.empty()) {
+                    while (isSpace(*pos))
+                        ++pos;
+                    if (pos == end)
+                        return Finish;
+                    if (*pos != '<')
+                        fail(pos, "content outside of root element");
+                }
+                else {
+                    char *p = static_cast<char*>(std::memchr(pos, '<', end - pos));
+                    if (!p)
+                        fail(pos, "unexpected end of document");
+                    textBegin = pos;
+                    textEnd = p;
+                    textMode = NormalizeText;
+                    pos = p;
+                    return Text;
+                }
+            }
+
+            if (pos[1] == '/')
+                return endTag();
+            if (std::strncmp(pos, "<![CDATA[", 9) == 0) {
+                char *p = std::strstr(pos + 9, "]]>");
+                if (!p || stack.empty())
+                    fail(pos, "invalid CDATA section");
+                textBegin = pos + 9;
+                textEnd = p;
+                textMode = NormalizeCData;
+                pos = p + 3;
+                return Text;
+            }
+            if (skipMarkup())
+                continue;
+            if (stack.empty() && started)
+                fail(pos, "multiple root elements");
+            return startTag();
+        }
+    }
+
+    /// Decode the character content of the last Text event
+    void decodeChars()
+    {
+        char *e = normalizeInSitu(textBegin, textEnd, textMode);
+        if (!e)
+            fail(textBegin, "invalid reference in character content");
+        chars = textBegin;
+        charSize = e - textBegin;
+    }
+
+    const char *attribute(const char *attr) const
+    {
+        for (const auto &v : attrs) {
+            if (std::strcmp(v.first, attr) == 0)
+                return v.second;
+        }
+        return nullptr;
+    }
+
+    char *pos;
+    char *begin;
+    char *end;
+    bool started = false;
+
+    const char *name = nullptr;
+    std::vector<std::pair<const char*, const char*> > attrs;
+    std::vector<const char*> stack;
+
+    char *textBegin = nullptr;
+    char *textEnd = nullptr;
+    NormalizeMode textMode = NormalizeText;
+    const char *chars = nullptr;
+    std::size_t charSize = 0;
+
+private:
+    void fail(const char *p, const char *msg) const
+    {
+        FC_READER_THROW("XML parse error at offset " << (p - begin) << ": " << msg);
+    }
+
+    /// Skip a comment or processing instruction
+    bool skipMarkup()
+    {
+        if (pos[1] == '?') {
+            char *p = std::strstr(pos + 2, "?>");
+            if (!p)
+                fail(pos, "unterminated processing instruction");
+            pos = p + 2;
+            return true;
+        }
+        if (std::strncmp(pos, "<!--", 4) == 0) {
+            char *p = std::strstr(pos + 4, "-->");
+            if (!p)
+                fail(pos, "unterminated comment");
+            pos = p + 3;
+            return true;
+        }
+        return false;
+    }
+
+    /// Strip the namespace prefix like Xerces does for the local name
+    static const char *localName(const char *qname)
+    {
+        const char *colon = std::strrchr(qname, ':');
+        return colon ? colon + 1 : qname;
+    }
+
+    Event startTag()
+    {
+        char *qname = pos + 1;
+        char *p = qname;
+        while (!isNameEnd(*p))
+            ++p;
+        if (p == qname)
+            fail(pos, "invalid element name");
+        char *nameEnd = p;
+
+        bool empty = false;
+        attrs.clear();
+        for (;;) {
+            while (isSpace(*p))
+                ++p;
+            if (*p == '>') {
+                ++p;
+                break;
+            }
+            if (*p == '/') {
+                if (p[1] != '>')
+                    fail(p, "invalid empty element tag");
+                p += 2;
+                empty = true;
+                break;
+            }
+
+            char *attr = p;
+            while (!isNameEnd(*p))
+                ++p;
+            if (p == attr)
+                fail(p, "invalid attribute name");
+            char *attrEnd = p;
+            while (isSpace(*p))
+                ++p;
+            if (*p != '=')
+                fail(p, "expected '=' after attribute name");
+            ++p;
+            while (isSpace(*p))
+                ++p;
+            char quote = *p;
+            if (quote != '"' && quote != '\'')
+                fail(p, "expected quoted attribute value");
+            char *value = ++p;
+            p = static_cast<char*>(std::memchr(value, quote, end - value));
+            if (!p)
+                fail(value, "unterminated attribute value");
+            char *valueEnd = normalizeInSitu(value, p, NormalizeAttribute);
+            if (!valueEnd)
+                fail(value, "invalid reference in attribute value");
+            ++p;
+            *attrEnd = 0;
+            *valueEnd = 0;
+            attrs.emplace_back(attr, value);
+        }
+        *nameEnd = 0;
+
+        pos = p;
+        name = localName(qname);
+        started = true;
+        if (empty)
+            return StartEnd;
+        stack.push_back(qname);
+        return Start;
+    }
+
+    Event endTag()
+    {
+        char *qname = pos + 2;
+        char *p = qname;
+        while (!isNameEnd(*p))
+            ++p;
+        char *nameEnd = p;
+        while (isSpace(*p))
+            ++p;
+        if (*p != '>' || stack.empty())
+            fail(pos, "invalid end tag");
+        *nameEnd = 0;
+        if (std::strcmp(stack.back(), qname) != 0)
+            fail(pos, "end tag does not match start tag");
+        stack.pop_back();
+
+        pos = p + 1;
+        name = localName(qname);
+        return End;
+    }
+};
+
 // ---------------------------------------------------------------------------
 //  Base::XMLReader: Constructors and Destructor
 // ---------------------------------------------------------------------------
 
-Base::XMLReader::XMLReader(Base::Reader &reader, std::size_t bufsize)
+Base::XMLReader::XMLReader(Base::Reader &reader, std::size_t bufsize, ParserType type)
   : DocumentSchema(0), ProgramVersion(""), FileVersion(reader.getFileVersion()), Level(0),
-    CharacterOffset(-1), ReadType(None), _File(reader.getFileName()), _valid(false),
+    CharacterOffset(-1), ReadType(None), _File(reader.getFileName()), parser(nullptr), _valid(false),
     _verbose(true), _reader(&reader), _ownReader(false)
 {
-    init(bufsize);
+    init(bufsize, type);
 }
 
-Base::XMLReader::XMLReader(const char *name, std::istream &str, std::size_t bufsize)
+Base::XMLReader::XMLReader(const char *name, std::istream &str, std::size_t bufsize, ParserType type)
   : DocumentSchema(0), ProgramVersion(""), FileVersion(0), Level(0),
-    CharacterOffset(-1), ReadType(None), _File(name), _valid(false),
+    CharacterOffset(-1), ReadType(None), _File(name), parser(nullptr), _valid(false),
     _verbose(true),_reader(new Base::Reader(str,name)), _ownReader(true)
 {
-    init(bufsize);
+    init(bufsize, type);
 }
 
-void Base::XMLReader::init(std::size_t bufsize) {
+void Base::XMLReader::init(std::size_t bufsize, ParserType type) {
 #ifdef _MSC_VER
     _reader->imbue(std::locale::empty());
 #else
     _reader->imbue(std::locale::classic());
 #endif
 
+    if (type == InSituParser && initInSitu(bufsize))
+        return;
+
     // create the parser
     parser = XMLReaderFactory::createXMLReader();
     //parser->setFeature(XMLUni::fgSAX2CoreNameSpaces, false);
@@ -142,8 +511,17 @@ void Base::XMLReader::init(std::size_t bufsize) {
     parser->setErrorHandler(this);
 
     try {
-        StdInputSource file(*_reader, _File.filePath().c_str());
-        _valid = parser->parseFirst(file, token);
+        if (!_buffer.empty()) {
+            // The in-situ parser has already consumed the stream but cannot
+            // handle the document, so let Xerces parse the loaded buffer.
+            MemBufInputSource file(reinterpret_cast<const XMLByte*>(_buffer.data()),
+                    _buffer.size() - 1, _File.filePath().c_str());
+            _valid = parser->parseFirst(file, token);
+        }
+        else {
+            StdInputSource file(*_reader, _File.filePath().c_str());
+            _valid = parser->parseFirst(file, token);
+        }
     }
     catch (const XMLException& toCatch) {
         char* message = XMLString::transcode(toCatch.getMessage());
@@ -164,6 +542,40 @@ void Base::XMLReader::init(std::size_t bufsize) {
 #endif
 }
 
+bool Base::XMLReader::initInSitu(std::size_t bufsize)
+{
+    std::streambuf *buf = _reader->rdbuf();
+    if (!buf)
+        return false;
+
+    std::size_t size = 0;
+    for (;;) {
+        _buffer.resize(size + bufsize);
+        std::streamsize count = buf->sgetn(_buffer.data() + size, bufsize);
+        if (count <= 0)
+            break;
+        size += count;
+    }
+    _buffer.resize(size + 1);
+    _buffer[size] = 0;
+
+    _inSitu.reset(new InSituData(_buffer));
+    if (!_inSitu->prolog()) {
+        FC_LOG("Fall back to Xerces parser for " << _File.filePath());
+        _inSitu.reset();
+        return false;
+    }
+
+    ReadType = StartDocument;
+    _valid = true;
+    return true;
+}
+
+Base::XMLReader::ParserType Base::XMLReader::parserType() const
+{
+    return _inSitu ? InSituParser : XercesParser;
+}
+
 Base::XMLReader::~XMLReader()
 {
     //  Delete the parser itself.  Must be done prior to calling Terminate, below.
@@ -179,6 +591,8 @@ const char* Base::XMLReader::localName(void) const
 
 unsigned int Base::XMLReader::getAttributeCount(void) const
 {
+    if (_inSitu)
+        return (unsigned int)_inSitu->attrs.size();
     return (unsigned int)AttrMap.size();
 }
 
@@ -199,12 +613,17 @@ double Base::XMLReader::getAttributeAsFloat  (const char* AttrName, const char *
 
 const char*  Base::XMLReader::getAttribute (const char* AttrName, const char *def) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
-
-    if (pos != AttrMap.end()) {
-        return pos->second.c_str();
+    if (_inSitu) {
+        if (const char *value = _inSitu->attribute(AttrName))
+            return value;
     }
-    else if(def) 
+    else {
+        AttrMapType::const_iterator pos = AttrMap.find(AttrName);
+        if (pos != AttrMap.end())
+            return pos->second.c_str();
+    }
+
+    if(def) 
         return def;
     else {
         _FC_READER_THROW(Base::XMLAttributeError, "XML Attribute: '" << AttrName << "' not found");
@@ -213,6 +632,8 @@ const char*  Base::XMLReader::getAttribute (const char* AttrName, const char *de
 
 bool Base::XMLReader::hasAttribute (const char* AttrName) const
 {
+    if (_inSitu)
+        return _inSitu->attribute(AttrName) != nullptr;
     return AttrMap.find(AttrName) != AttrMap.end();
 }
 
@@ -223,6 +644,11 @@ void Base::XMLReader::read(void)
 
     ReadType = None;
 
+    if (_inSitu) {
+        readInSitu();
+        return;
+    }
+
     try {
         parser->parseNext(token);
     }
@@ -264,11 +690,50 @@ void Base::XMLReader::read(void)
     }
 }
 
+void Base::XMLReader::readInSitu()
+{
+    switch (_inSitu->next()) {
+    case InSituData::Start:
+        Level++;
+        LocalName = _inSitu->name;
+        ReadType = StartElement;
+        break;
+    case InSituData::StartEnd:
+        // Xerces reports an empty element as start and end element at once,
+        // which leaves the level untouched
+        LocalName = _inSitu->name;
+        ReadType = StartEndElement;
+        if(Guards.size() && Level<*Guards.back())
+            *Guards.back() = INT_MAX;
+        break;
+    case InSituData::End:
+        Level--;
+        LocalName = _inSitu->name;
+        ReadType = EndElement;
+        if(Guards.size() && Level<*Guards.back())
+            *Guards.back() = INT_MAX;
+        break;
+    case InSituData::Text:
+        ReadType = Chars;
+        // We only decode characters when some one wants it
+        if(CharacterOffset>=0) {
+            _inSitu->decodeChars();
+            CharacterOffset = 0;
+        }
+        break;
+    case InSituData::Finish:
+        ReadType = EndDocument;
+        break;
+    }
+}
+
 void Base::XMLReader::readElement(const char* ElementName, int *guard)
 {
     endCharStream();
 
     AttrMap.clear();
+    if (_inSitu)
+        _inSitu->attrs.clear();
 
     int currentLevel = Level;
     std::string currentName = LocalName;
@@ -356,10 +821,16 @@ std::streamsize Base::XMLReader::read(char_type* s, std::streamsize n) {
         return -1;
 
     for(;;) {
-        std::streamsize copy_size = Characters.size()-CharacterOffset;
+        const char *chars = Characters.c_str();
+        std::streamsize size = Characters.size();
+        if(_inSitu) {
+            chars = _inSitu->chars;
+            size = _inSitu->charSize;
+        }
+        std::streamsize copy_size = size-CharacterOffset;
         if(n<copy_size)
             copy_size = n;
-        std::memcpy(s,Characters.c_str()+CharacterOffset,copy_size);
+        std::memcpy(s,chars+CharacterOffset,copy_size);
         n -= copy_size;
         s += copy_size;
         CharacterOffset += copy_size;
@@ -402,6 +873,8 @@ std::istream &Base::XMLReader::beginCharStream(bool base64) {
 
     CharacterOffset = 0;
     Characters.clear();
+    if(_inSitu)
+        _inSitu->charSize = 0;
 
     read();
     CharStream.reset(new bio::filtering_istream);
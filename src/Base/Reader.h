@@ -28,6 +28,7 @@
 #include <map>
 #include <bitset>
 #include <memory>
+#include <vector>
 
 #include <xercesc/framework/XMLPScanToken.hpp>
 #include <xercesc/sax2/Attributes.hpp>
@@ -128,9 +129,22 @@ public:
         PartialRestoreInProperty = 2,           // Local to the Property
         PartialRestoreInObject = 3              // Local to the object partially restored itself
     };
-    /// open the file and read the first element
-    XMLReader(Base::Reader &reader, std::size_t bufsize=16*1024);
-    XMLReader(const char *name, std::istream &, std::size_t bufsize=16*1024);
+    /// The parser backend used to tokenize the document
+    enum ParserType {
+        XercesParser,   // Xerces SAX2 parser (default)
+        InSituParser    // Light weight UTF-8 parser working on a single in-memory buffer
+    };
+    /** open the file and read the first element
+     *
+     * The in-situ parser loads the whole stream into memory and tokenizes it
+     * without transcoding, storing element names and attribute values as
+     * pointers into the buffer. It only understands UTF-8 (or ASCII) input
+     * without DTD processing, and silently falls back to Xerces otherwise.
+     */
+    XMLReader(Base::Reader &reader, std::size_t bufsize=16*1024,
+              ParserType type=XercesParser);
+    XMLReader(const char *name, std::istream &, std::size_t bufsize=16*1024,
+              ParserType type=XercesParser);
     ~XMLReader();
 
     /** @name boost iostream device interface */
@@ -141,6 +155,8 @@ public:
     //@}
 
     bool isValid() const { return _valid; }
+    /// Return the parser backend of this reader
+    ParserType parserType() const;
     bool isVerbose() const { return _verbose; }
     void setVerbose(bool on) { _verbose = on; }
 
@@ -278,7 +294,9 @@ public:
 
 protected:
 
-    void init(std::size_t bufsize);
+    void init(std::size_t bufsize, ParserType type);
+    bool initInSitu(std::size_t bufsize);
+    void readInSitu();
 
     // -----------------------------------------------------------------------
     //  Handlers for the SAX ContentHandler interface
@@ -359,6 +377,10 @@ protected:
 
     Base::Reader *_reader;
     bool _ownReader;
+
+    std::vector<char> _buffer;
+    struct InSituData;
+    std::unique_ptr<InSituData> _inSitu;
 };
 
 class BaseExport Reader : public std::istream
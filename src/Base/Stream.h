@@ -35,6 +35,7 @@
 #include <sstream>
 #include <string>
 #include <vector>
+#include <type_traits>
 #include "Swap.h"
 #include "FileInfo.h"
 
@@ -188,6 +189,22 @@ public:
         return *this;
     }
 
+    /** Writes an array of numbers.
+     * In binary mode without byte swapping the whole array is written
+     * with a single call, otherwise it falls back to writing value by value.
+     */
+    template<typename T>
+    OutputStream& write(const T* values, std::size_t count) {
+        static_assert(std::is_arithmetic<T>::value, "Expects an array of numbers");
+        if(_binary && !_swap)
+            _out.write((const char*)values, sizeof(T)*count);
+        else {
+            for(std::size_t i=0; i<count; ++i)
+                (*this) << values[i];
+        }
+        return *this;
+    }
+
 
     bool isBinary() const {return _binary;}
 
@@ -322,6 +339,27 @@ public:
         return *this;
     }
 
+    /** Reads an array of numbers.
+     * In binary mode the whole array is read with a single call and then
+     * byte swapped if needed, otherwise it is read value by value.
+     */
+    template<typename T>
+    InputStream& read(T* values, std::size_t count) {
+        static_assert(std::is_arithmetic<T>::value, "Expects an array of numbers");
+        if(_binary) {
+            _in.read((char*)values, sizeof(T)*count);
+            if (_swap) {
+                for(std::size_t i=0; i<count; ++i)
+                    SwapEndian<T>(values[i]);
+            }
+        }
+        else {
+            for(std::size_t i=0; i<count; ++i)
+                (*this) >> values[i];
+        }
+        return *this;
+    }
+
     operator bool() const
     {
         // test if _Ipfx succeeded
@@ -2653,12 +2653,10 @@ static void selectionCallback(void * ud, SoEventCallback * cb)
 
         auto picked = view->getPickedList(points, center, selectElement, backFaceCull,
                                         currentSelection, unselect, false);
-        for (auto &objT : picked) {
-            if (unselect)
-                Selection().rmvSelection(objT);
-            else
-                Selection().addSelection(objT);
-        }
+        if (unselect)
+            Selection().rmvSelections(picked);
+        else
+            Selection().addSelections(picked);
     }
 
     if (singleSelect) {
@@ -73,6 +73,7 @@
 #include "WaitCursor.h"
 #include "Thumbnail.h"
 #include "ViewProviderLink.h"
+#include "ViewParams.h"
 
 FC_LOG_LEVEL_INIT("Gui",true,true)
 
@@ -977,6 +978,10 @@ void Document::slotRecomputed(const App::Document& doc,
             vp->updateChildren(false);
     }
 
+    int budget = ViewParams::getSceneMemoryBudget();
+    if (budget > 0)
+        LinkView::applyMemoryBudget(this, std::size_t(budget) * 1024 * 1024);
+
     getMainWindow()->updateActions();
     TreeWidget::updateStatus();
 }
@@ -45,6 +45,8 @@
 #include "ViewProviderDocumentObjectPy.h"
 #include "ViewProviderPy.h"
 #include "ViewProviderDocumentObjectPy.h"
+#include "ViewProviderLink.h"
+#include "ViewParams.h"
 
 
 using namespace Gui;
@@ -351,6 +353,58 @@ PyObject* DocumentPy::toggleInSceneGraph(PyObject *args) {
     Py_Return;
 }
 
+static Py::Dict statisticsToDict(const LinkView::Statistics &stats)
+{
+    Py::Dict dict;
+    dict.setItem("Nodes", Py::Long(static_cast<unsigned long>(stats.nodeCount)));
+    dict.setItem("Instances", Py::Long(static_cast<unsigned long>(stats.instanceCount)));
+    dict.setItem("CoordinateBytes", Py::Long(static_cast<unsigned long>(stats.coordinateBytes)));
+    dict.setItem("IndexBytes", Py::Long(static_cast<unsigned long>(stats.indexBytes)));
+    dict.setItem("InstanceBytes", Py::Long(static_cast<unsigned long>(stats.instanceBytes)));
+    dict.setItem("SharingRatio", Py::Float(stats.sharingRatio()));
+    return dict;
+}
+
+PyObject* DocumentPy::getSceneStatistics(PyObject *args)
+{
+    PyObject *perObject = Py_False;
+    if (!PyArg_ParseTuple(args, "|O", &perObject))
+        return 0;
+
+    PY_TRY {
+        std::vector<std::pair<ViewProviderDocumentObject*, LinkView::Statistics> > objStats;
+        auto stats = LinkView::getDocumentStatistics(getDocumentPtr(),
+                PyObject_IsTrue(perObject) ? &objStats : nullptr);
+        Py::Dict dict = statisticsToDict(stats);
+        if (PyObject_IsTrue(perObject)) {
+            Py::Dict objects;
+            for (auto &v : objStats)
+                objects.setItem(v.first->getObject()->getNameInDocument(), statisticsToDict(v.second));
+            dict.setItem("Objects", objects);
+        }
+        return Py::new_reference_to(dict);
+    } PY_CATCH;
+}
+
+PyObject* DocumentPy::applyMemoryBudget(PyObject *args)
+{
+    long long budget = -1;
+    if (!PyArg_ParseTuple(args, "|L", &budget))
+        return 0;
+
+    PY_TRY {
+        if (budget < 0) {
+            // a zero parameter means the budget is switched off
+            int param = ViewParams::getSceneMemoryBudget();
+            if (param <= 0)
+                return Py::new_reference_to(Py::Long(0));
+            budget = static_cast<long long>(param) * 1024 * 1024;
+        }
+        std::size_t released = LinkView::applyMemoryBudget(getDocumentPtr(), static_cast<std::size_t>(budget));
+        return Py::new_reference_to(Py::Long(static_cast<unsigned long>(released)));
+    } PY_CATCH;
+}
+
 Py::Object DocumentPy::getActiveObject(void) const
 {
     App::DocumentObject *object = getDocumentPtr()->getDocument()->getActiveObject();
@@ -154,6 +154,7 @@
 #include <Inventor/nodes/SoTransform.h>
 #include <Inventor/nodes/SoTranslation.h>
 #include <Inventor/nodes/SoTransparencyType.h>
+#include <Inventor/nodes/SoVertexProperty.h>
 #include <Inventor/nodekits/SoShapeKit.h>
 #include <Inventor/manips/SoTransformBoxManip.h>
 #include <Inventor/projectors/SbSpherePlaneProjector.h>
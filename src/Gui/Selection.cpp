@@ -24,6 +24,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
 # include <assert.h>
 # include <string>
 # include <boost_bind_bind.hpp>
@@ -65,6 +66,33 @@ using namespace Gui;
 using namespace std;
 namespace bp = boost::placeholders;
 
+// Calls func with one AddSelection/RmvSelection message for each element of
+// the given AddSelections/RmvSelections message
+template<class F>
+static void expandBatchSelection(const SelectionChanges &msg, F &&func)
+{
+    auto type = msg.Type == SelectionChanges::AddSelections ?
+        SelectionChanges::AddSelection : SelectionChanges::RmvSelection;
+    const SelectionChanges *pOriginalMsg = msg.pOriginalMsg;
+    if(pOriginalMsg && pOriginalMsg->SubObjects.size() != msg.SubObjects.size())
+        pOriginalMsg = 0;
+    for(std::size_t i=0; i<msg.SubObjects.size(); ++i) {
+        const auto &objT = msg.SubObjects[i];
+        auto obj = objT.getObject();
+        SelectionChanges Chng(type, objT.getDocumentName(), objT.getObjectName(),
+                objT.getSubName(), obj?obj->getTypeId().getName():"");
+        SelectionChanges OrigChng;
+        if(pOriginalMsg) {
+            const auto &origT = pOriginalMsg->SubObjects[i];
+            auto origObj = origT.getObject();
+            OrigChng = SelectionChanges(type, origT.getDocumentName(), origT.getObjectName(),
+                    origT.getSubName(), origObj?origObj->getTypeId().getName():"");
+            Chng.pOriginalMsg = &OrigChng;
+        }
+        func(Chng);
+    }
+}
+
 SelectionGateFilterExternal::SelectionGateFilterExternal(const char *docName, const char *objName) {
     if(docName) {
         DocName = docName;
@@ -88,14 +116,14 @@ bool SelectionGateFilterExternal::allow(App::Document *doc ,App::DocumentObject
 //////////////////////////////////////////////////////////////////////////////////////////
 
 SelectionObserver::SelectionObserver(bool attach,int resolve)
-    :resolve(resolve),blockSelection(false)
+    :resolve(resolve),blockSelection(false),batchSelection(false)
 {
     if(attach)
         attachSelection();
 }
 
 SelectionObserver::SelectionObserver(const ViewProviderDocumentObject *vp,bool attach,int resolve)
-    :resolve(resolve),blockSelection(false)
+    :resolve(resolve),blockSelection(false),batchSelection(false)
 {
     if(vp && vp->getObject() && vp->getObject()->getDocument()) {
         filterDocName = vp->getObject()->getDocument()->getName();
@@ -131,6 +159,11 @@ bool SelectionObserver::isConnectionAttached() const
     return connectSelection.connected();
 }
 
+void SelectionObserver::setBatchSelection(bool enable)
+{
+    batchSelection = enable;
+}
+
 void SelectionObserver::attachSelection()
 {
     if (!connectSelection.connected()) {
@@ -151,6 +184,14 @@ void SelectionObserver::_onSelectionChanged(const SelectionChanges& msg) {
     try {
         if (blockSelection)
             return;
+        if (!batchSelection && (msg.Type == SelectionChanges::AddSelections
+                                || msg.Type == SelectionChanges::RmvSelections))
+        {
+            expandBatchSelection(msg, [this](const SelectionChanges &Chng) {
+                onSelectionChanged(Chng);
+            });
+            return;
+        }
         onSelectionChanged(msg);
     } catch (Base::Exception &e) {
         e.ReportException();
@@ -618,11 +659,35 @@ void SelectionSingleton::notify(SelectionChanges &&Chng) {
         case SelectionChanges::RmvPreselect:
             notify = CurrentPreselection.Type==SelectionChanges::ClrSelection;
             break;
+        case SelectionChanges::AddSelections:
+        case SelectionChanges::RmvSelections: {
+            // Same as above, skip elements whose selection state has changed
+            // again since the message is queued.
+            bool add = msg.Type == SelectionChanges::AddSelections;
+            auto &objs = NotificationQueue.front().SubObjects;
+            objs.erase(std::remove_if(objs.begin(), objs.end(),
+                [this,add](const App::SubObjectT &objT) {
+                    return add != isSelected(objT.getDocumentName().c_str(),
+                                             objT.getObjectName().c_str(),
+                                             objT.getSubName().c_str(),0);
+                }), objs.end());
+            notify = !objs.empty();
+            break;
+        }
         default:
             notify = true;
         }
         if(notify) {
-            Notify(msg);
+            if(msg.Type == SelectionChanges::AddSelections
+                    || msg.Type == SelectionChanges::RmvSelections)
+            {
+                // Plain subject observers do not know about batch messages
+                expandBatchSelection(msg, [this](const SelectionChanges &Chng) {
+                    Notify(Chng);
+                });
+            }
+            else
+                Notify(msg);
             try {
                 signalSelectionChanged(msg);
             }
@@ -750,7 +815,55 @@ void SelectionSingleton::slotSelectionChanged(const SelectionChanges& msg) {
     if(msg.Type == SelectionChanges::ShowSelection ||
        msg.Type == SelectionChanges::HideSelection)
         return;
-    
+
+    if(msg.Type == SelectionChanges::AddSelections ||
+       msg.Type == SelectionChanges::RmvSelections)
+    {
+        // Resolve each element. 'orig' keeps the original elements that are
+        // resolved, so that they stay in sync with the resolved ones.
+        SelectionChanges orig(msg.Type, msg.pDocName);
+        SelectionChanges msg2(msg.Type, msg.pDocName);
+        std::vector<std::string> oldElementNames;
+        for(auto &objT : msg.SubObjects) {
+            if(objT.getSubName().empty()) {
+                orig.SubObjects.push_back(objT);
+                msg2.SubObjects.push_back(objT);
+                oldElementNames.emplace_back();
+                continue;
+            }
+            auto pParent = objT.getObject();
+            if(!pParent)
+                continue;
+            std::pair<std::string,std::string> elementName;
+            auto &newElementName = elementName.first;
+            auto &oldElementName = elementName.second;
+            auto pObject = App::GeoFeature::resolveElement(
+                    pParent,objT.getSubName().c_str(),elementName);
+            if (!pObject)
+                continue;
+            orig.SubObjects.push_back(objT);
+            msg2.SubObjects.emplace_back(pObject,
+                    newElementName.size()?newElementName.c_str():oldElementName.c_str());
+            oldElementNames.push_back(std::move(oldElementName));
+        }
+        if(msg2.SubObjects.empty())
+            return;
+
+        try {
+            msg2.pOriginalMsg = &orig;
+            signalSelectionChanged3(msg2);
+
+            for(std::size_t i=0; i<msg2.SubObjects.size(); ++i)
+                msg2.SubObjects[i].setSubName(oldElementNames[i].c_str());
+            signalSelectionChanged2(msg2);
+        }
+        catch (const boost::exception&) {
+            // reported by code analyzers
+            Base::Console().Warning("slotSelectionChanged: Unexpected boost exception\n");
+        }
+        return;
+    }
+
     if(msg.Object.getSubName().size()) {
         auto pParent = msg.Object.getObject();
         if(!pParent) return;
@@ -1089,6 +1202,110 @@ void SelectionSingleton::_SelObj::log(bool remove, bool clearPreselect) {
     Application::Instance->macroManager()->addLine(MacroManager::Cmt, ss.str().c_str());
 }
 
+std::string SelectionSingleton::_SelObj::key(const std::string &docName,
+        const std::string &objName, const std::string &subName)
+{
+    std::string res;
+    res.reserve(docName.size() + objName.size() + subName.size() + 2);
+    res += docName;
+    res += '#';
+    res += objName;
+    res += '.';
+    res += subName;
+    return res;
+}
+
+std::string SelectionSingleton::_SelObj::elementKey() const
+{
+    // See checkSelection() with resolve == 1. A selection with new style
+    // element name is matched by that name, otherwise by its sub-object name.
+    if(elementName.first.size())
+        return "N" + elementName.first;
+    return "O" + SubName;
+}
+
+SelectionSingleton::_SelIter SelectionSingleton::addSelObj(const _SelObj &sel)
+{
+    auto it = _SelList.insert(_SelList.end(), sel);
+    _SelMap.emplace(it->key(), it);
+    if(it->pResolvedObject)
+        _SelResolvedMap[it->pResolvedObject].emplace(it->elementKey(), it);
+    return it;
+}
+
+SelectionSingleton::_SelIter SelectionSingleton::rmvSelObj(_SelIter it)
+{
+    auto itKey = _SelMap.find(it->key());
+    if(itKey != _SelMap.end() && itKey->second == it)
+        _SelMap.erase(itKey);
+
+    auto itRes = _SelResolvedMap.find(it->pResolvedObject);
+    if(itRes != _SelResolvedMap.end()) {
+        auto &elements = itRes->second;
+        auto range = elements.equal_range(it->elementKey());
+        for(auto itElement=range.first; itElement!=range.second; ++itElement) {
+            if(itElement->second == it) {
+                elements.erase(itElement);
+                break;
+            }
+        }
+        if(elements.empty())
+            _SelResolvedMap.erase(itRes);
+    }
+    return _SelList.erase(it);
+}
+
+void SelectionSingleton::clearSelObjs()
+{
+    _SelMap.clear();
+    _SelResolvedMap.clear();
+    _SelList.clear();
+}
+
+bool SelectionSingleton::checkSelObj(const _SelObj &sel, const char *pSubName,
+        const std::string &prefix, int resolve) const
+{
+    if(_SelMap.count(_SelObj::key(sel.DocName, sel.FeatName, pSubName)))
+        return true;
+
+    if(resolve>1) {
+        auto key = _SelObj::key(sel.DocName, sel.FeatName, prefix);
+        auto it = _SelMap.lower_bound(key);
+        if(it!=_SelMap.end() && boost::starts_with(it->first, key))
+            return true;
+    }
+
+    if(resolve==1) {
+        auto it = _SelResolvedMap.find(sel.pResolvedObject);
+        if(it == _SelResolvedMap.end())
+            return false;
+        if(!pSubName[0])
+            return true;
+        const auto &elements = it->second;
+        if(sel.elementName.first.size() && elements.count("N" + sel.elementName.first))
+            return true;
+        if(elements.count("O" + sel.elementName.second))
+            return true;
+    }
+    return false;
+}
+
+void SelectionSingleton::findSelObjs(const _SelObj &sel, std::vector<_SelIter> &res)
+{
+    // if no subname is specified, match all subobjects of the object,
+    // otherwise, match subojects with common prefix, separated by '.'
+    auto key = sel.key();
+    for(auto it=_SelMap.lower_bound(key); it!=_SelMap.end(); ++it) {
+        if(!boost::starts_with(it->first, key))
+            break;
+        const auto &subname = it->second->SubName;
+        if(sel.SubName.size() && subname.length()!=sel.SubName.length()
+                && subname[sel.SubName.length()-1]!='.')
+            continue;
+        res.push_back(it->second);
+    }
+}
+
 bool SelectionSingleton::addSelection(const char* pDocName, const char* pObjectName, 
         const char* pSubName, float x, float y, float z, 
         const std::vector<SelObj> *pickedList, bool clearPreselect)
@@ -1145,7 +1362,7 @@ bool SelectionSingleton::addSelection(const char* pDocName, const char* pObjectN
     if(!logDisabled)
         temp.log(false,clearPreselect);
 
-    _SelList.push_back(temp);
+    addSelObj(temp);
     _SelStackForward.clear();
 
     if(clearPreselect)
@@ -1307,7 +1524,7 @@ bool SelectionSingleton::addSelections(const char* pDocName, const char* pObject
         temp.y        = 0;
         temp.z        = 0;
 
-        _SelList.push_back(temp);
+        addSelObj(temp);
         _SelStackForward.clear();
 
         SelectionChanges Chng(SelectionChanges::AddSelection,
@@ -1324,6 +1541,107 @@ bool SelectionSingleton::addSelections(const char* pDocName, const char* pObject
     return true;
 }
 
+int SelectionSingleton::addSelections(const std::vector<App::SubObjectT> &objs, bool clearPreselect)
+{
+    if(_PickedList.size()) {
+        _PickedList.clear();
+        notify(SelectionChanges(SelectionChanges::PickedListChanged));
+    }
+
+    int count = 0;
+    bool rejected = false;
+    std::map<std::string, std::vector<App::SubObjectT> > docs;
+    for(auto &objT : objs) {
+        _SelObj temp;
+        if(checkSelection(objT.getDocumentName().c_str(),
+                          objT.getObjectName().c_str(),
+                          objT.getSubName().c_str(),0,temp)!=0)
+            continue;
+
+        if (ActiveGate) {
+            const char *subelement = 0;
+            auto pObject = getObjectOfType(temp,App::DocumentObject::getClassTypeId(),gateResolve,&subelement);
+            if (!ActiveGate->allow(pObject?pObject->getDocument():temp.pDoc,pObject,subelement)) {
+                rejected = true;
+                continue;
+            }
+        }
+
+        if(!logDisabled)
+            temp.log(false,clearPreselect);
+
+        FC_LOG("Add Selection "<<temp.DocName<<'#'<<temp.FeatName<<'.'<<temp.SubName);
+
+        docs[temp.DocName].emplace_back(temp.DocName.c_str(),
+                temp.FeatName.c_str(), temp.SubName.c_str());
+        addSelObj(temp);
+        ++count;
+    }
+
+    if(rejected && ActiveGate) {
+        ActiveGate->notAllowedReason.clear();
+        QApplication::beep();
+    }
+
+    if(!count)
+        return 0;
+
+    _SelStackForward.clear();
+
+    if(clearPreselect)
+        rmvPreselect();
+
+    // One aggregated notification per document instead of one per selection
+    for(auto &v : docs) {
+        SelectionChanges Chng(SelectionChanges::AddSelections,v.first.c_str());
+        Chng.SubObjects = std::move(v.second);
+        notify(std::move(Chng));
+    }
+
+    getMainWindow()->updateActions();
+    return count;
+}
+
+int SelectionSingleton::rmvSelections(const std::vector<App::SubObjectT> &objs)
+{
+    int count = 0;
+    std::map<std::string, std::vector<App::SubObjectT> > docs;
+    std::vector<_SelIter> sels;
+    for(auto &objT : objs) {
+        _SelObj temp;
+        if(checkSelection(objT.getDocumentName().c_str(),
+                          objT.getObjectName().c_str(),
+                          objT.getSubName().c_str(),0,temp)<0)
+            continue;
+
+        sels.clear();
+        findSelObjs(temp, sels);
+        for(auto It : sels) {
+            It->log(true);
+
+            FC_LOG("Rmv Selection "<<It->DocName<<'#'<<It->FeatName<<'.'<<It->SubName);
+
+            docs[It->DocName].emplace_back(It->DocName.c_str(),
+                    It->FeatName.c_str(), It->SubName.c_str());
+            rmvSelObj(It);
+            ++count;
+        }
+    }
+
+    if(!count)
+        return 0;
+
+    // One aggregated notification per document instead of one per selection
+    for(auto &v : docs) {
+        SelectionChanges Chng(SelectionChanges::RmvSelections,v.first.c_str());
+        Chng.SubObjects = std::move(v.second);
+        notify(std::move(Chng));
+    }
+
+    getMainWindow()->updateActions();
+    return count;
+}
+
 bool SelectionSingleton::updateSelection(bool show, const char* pDocName, 
                             const char* pObjectName, const char* pSubName)
 {
@@ -1413,26 +1731,18 @@ void SelectionSingleton::rmvSelection(const char* pDocName, const char* pObjectN
     if(ret<0)
         return;
 
-    std::vector<SelectionChanges> changes;
-    for(auto It=_SelList.begin(),ItNext=It;It!=_SelList.end();It=ItNext) {
-        ++ItNext;
-        if(It->DocName!=temp.DocName || It->FeatName!=temp.FeatName) 
-            continue;
-        // if no subname is specified, remove all subobjects of the matching object
-        if(temp.SubName.size()) {
-            // otherwise, match subojects with common prefix, separated by '.'
-            if(!boost::starts_with(It->SubName,temp.SubName) ||
-               (It->SubName.length()!=temp.SubName.length() && It->SubName[temp.SubName.length()-1]!='.'))
-                continue;
-        }
+    std::vector<_SelIter> sels;
+    findSelObjs(temp, sels);
 
+    std::vector<SelectionChanges> changes;
+    for(auto It : sels) {
         It->log(true);
 
         changes.emplace_back(SelectionChanges::RmvSelection,
                 It->DocName,It->FeatName,It->SubName,It->TypeName);
 
         // destroy the _SelObj item
-        _SelList.erase(It);
+        rmvSelObj(It);
     }
 
     // NOTE: It can happen that there are nested calls of rmvSelection()
@@ -1577,7 +1887,7 @@ void SelectionSingleton::setSelection(const char* pDocName, const std::vector<Ap
         if(ret!=0)
             continue;
         touched = true;
-        _SelList.push_back(temp);
+        addSelObj(temp);
     }
 
     if(touched) {
@@ -1610,14 +1920,13 @@ void SelectionSingleton::clearSelection(const char* pDocName, bool clearPreSelec
             rmvPreselect();
 
         bool touched = false;
-        for (auto it=_SelList.begin();it!=_SelList.end();) {
-            if (it->DocName == docName) {
-                touched = true;
-                it = _SelList.erase(it);
-            }
-            else {
-                ++it;
-            }
+        std::string key = docName + "#";
+        for (auto it=_SelMap.lower_bound(key);it!=_SelMap.end();) {
+            if (!boost::starts_with(it->first, key))
+                break;
+            touched = true;
+            auto sel = (it++)->second;
+            rmvSelObj(sel);
         }
 
         if (!touched)
@@ -1656,7 +1965,7 @@ void SelectionSingleton::clearCompleteSelection(bool clearPreSelect)
                 clearPreSelect?"Gui.Selection.clearSelection()"
                               :"Gui.Selection.clearSelection(False)");
 
-    _SelList.clear();
+    clearSelObjs();
 
     SelectionChanges Chng(SelectionChanges::ClrSelection);
 
@@ -1743,6 +2052,9 @@ int SelectionSingleton::checkSelection(const char *pDocName, const char *pObject
     if(!pSubName)
         pSubName = "";
 
+    if(selList == &_SelList)
+        return checkSelObj(sel, pSubName, prefix, resolve) ? 1 : 0;
+
     for (auto &s : *selList) {
         if (s.DocName==pDocName && s.FeatName==sel.FeatName) {
             if(s.SubName==pSubName)
@@ -1801,15 +2113,26 @@ void SelectionSingleton::slotDeletedObject(const App::DocumentObject& Obj)
 
     // Remove also from the selection, if selected
     // We don't walk down the hierarchy for each selection, so there may be stray selection
-    std::vector<SelectionChanges> changes;
-    for(auto it=_SelList.begin(),itNext=it;it!=_SelList.end();it=itNext) {
-        ++itNext;
-        if(it->pResolvedObject == &Obj || it->pObject==&Obj) {
-            changes.emplace_back(SelectionChanges::RmvSelection,
-                    it->DocName,it->FeatName,it->SubName,it->TypeName);
-            _SelList.erase(it);
+    std::vector<_SelIter> sels;
+    std::string key = _SelObj::key(Obj.getDocument()->getName(), Obj.getNameInDocument(), "");
+    for(auto it=_SelMap.lower_bound(key);it!=_SelMap.end();++it) {
+        if(!boost::starts_with(it->first, key))
+            break;
+        sels.push_back(it->second);
+    }
+    auto itRes = _SelResolvedMap.find(&Obj);
+    if(itRes != _SelResolvedMap.end()) {
+        for(auto &v : itRes->second) {
+            if(v.second->pObject != &Obj)
+                sels.push_back(v.second);
         }
     }
+    std::vector<SelectionChanges> changes;
+    for(auto it : sels) {
+        changes.emplace_back(SelectionChanges::RmvSelection,
+                it->DocName,it->FeatName,it->SubName,it->TypeName);
+        rmvSelObj(it);
+    }
     if(changes.size()) {
         for(auto &Chng : changes) {
             FC_LOG("Rmv Selection "<<Chng.pDocName<<'#'<<Chng.pObjectName<<'.'<<Chng.pSubName);
@@ -30,6 +30,7 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <deque>
 #include <boost/signals2.hpp>
 #include <CXX/Objects.hxx>
@@ -76,6 +77,8 @@ public:
         ShowSelection, // to show a selection
         HideSelection, // to hide a selection
         MovePreselect, // to signal observer the mouse movement when preselect
+        AddSelections, // a batch of selections added, see SubObjects
+        RmvSelections, // a batch of selections removed, see SubObjects
     };
 
     SelectionChanges(MsgType type = ClrSelection, 
@@ -122,6 +125,7 @@ public:
         z = other.z;
         Object = other.Object;
         TypeName = other.TypeName;
+        SubObjects = other.SubObjects;
         pDocName = Object.getDocumentName().c_str();
         pObjectName = Object.getObjectName().c_str();
         pSubName = Object.getSubName().c_str();
@@ -142,6 +146,7 @@ public:
         z = other.z;
         Object = std::move(other.Object);
         TypeName = std::move(other.TypeName);
+        SubObjects = std::move(other.SubObjects);
         pDocName = Object.getDocumentName().c_str();
         pObjectName = Object.getObjectName().c_str();
         pSubName = Object.getSubName().c_str();
@@ -164,6 +169,14 @@ public:
     App::SubObjectT Object;
     std::string TypeName;
 
+    /** Selection elements of an AddSelections/RmvSelections message
+     *
+     * A batch message only sets pDocName. Observers that did not enable
+     * batch messages (see SelectionObserver::setBatchSelection()) receive one
+     * AddSelection/RmvSelection message per element instead.
+     */
+    std::vector<App::SubObjectT> SubObjects;
+
     // Original selection message in case resolve!=0
     const SelectionChanges *pOriginalMsg = 0;
 };
@@ -239,6 +252,15 @@ public:
     /** Detaches from the selection. */
     void detachSelection();
 
+    /** Enables receiving batch selection messages
+     *
+     * By default, an AddSelections/RmvSelections message is delivered as one
+     * AddSelection/RmvSelection message per element. Observers that handle
+     * SelectionChanges::SubObjects themselves can enable this to receive the
+     * batch message as is.
+     */
+    void setBatchSelection(bool enable);
+
 private:
     virtual void onSelectionChanged(const SelectionChanges& msg) = 0;
     void _onSelectionChanged(const SelectionChanges& msg);
@@ -250,6 +272,7 @@ private:
     std::string filterObjName;
     int resolve;
     bool blockSelection;
+    bool batchSelection;
 };
 
 /**
@@ -381,6 +404,29 @@ public:
     bool addSelection(const SelectionObject&, bool clearPreSelect=true);
     /// Add to selection with several sub-elements
     bool addSelections(const char* pDocName, const char* pObjectName, const std::vector<std::string>& pSubNames);
+    /** Add a batch of selections
+     *
+     * @param objs: the objects to be selected
+     * @param clearPreselect: whether to clear the current pre-selection
+     *
+     * @return Return the number of added selections.
+     *
+     * Unlike calling addSelection() for each object, the observers are
+     * notified with one AddSelections message for each involved document.
+     */
+    int addSelections(const std::vector<App::SubObjectT> &objs, bool clearPreselect=true);
+    /** Remove a batch of selections
+     *
+     * @param objs: the objects to be removed from the selection. Same as
+     *              rmvSelection(), sub-objects of each given object are
+     *              removed as well.
+     *
+     * @return Return the number of removed selections.
+     *
+     * The observers are notified with one RmvSelections message for each
+     * involved document.
+     */
+    int rmvSelections(const std::vector<App::SubObjectT> &objs);
     /// Update a selection 
     bool updateSelection(bool show, const char* pDocName, const char* pObjectName=0, const char* pSubName=0);
     /// Remove from selection
@@ -739,9 +785,31 @@ protected:
         App::DocumentObject* pResolvedObject = 0;
 
         void log(bool remove=false, bool clearPreselect=true);
+
+        static std::string key(const std::string &docName,
+                               const std::string &objName,
+                               const std::string &subName);
+        std::string key() const {
+            return key(DocName, FeatName, SubName);
+        }
+        std::string elementKey() const;
     };
     mutable std::list<_SelObj> _SelList;
 
+    typedef std::list<_SelObj>::iterator _SelIter;
+    /// Index of _SelList by document, object and sub-object name
+    std::map<std::string, _SelIter> _SelMap;
+    /// Index of _SelList by resolved object and element name
+    std::unordered_map<const App::DocumentObject*,
+        std::unordered_multimap<std::string, _SelIter> > _SelResolvedMap;
+
+    _SelIter addSelObj(const _SelObj &sel);
+    _SelIter rmvSelObj(_SelIter it);
+    void clearSelObjs();
+    bool checkSelObj(const _SelObj &sel, const char *pSubName,
+                     const std::string &prefix, int resolve) const;
+    void findSelObjs(const _SelObj &sel, std::vector<_SelIter> &res);
+
     mutable std::list<_SelObj> _PickedList;
     bool _needPickedList;
 
@@ -24,6 +24,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+#  include <algorithm>
 #  include <cassert>
 #  include <float.h>
 #  include <limits.h>
@@ -1600,3 +1601,89 @@ void SoFCRayPickAction::afterPick() {
     }
     reset();
 }
+
+///////////////////////////////////////////////////////////////////////////
+
+void SoFCRayPickTree::clear() {
+    nodes.clear();
+    items.clear();
+    centers.clear();
+}
+
+void SoFCRayPickTree::build(const std::vector<SbBox3f> &boxes, int leafSize) {
+    clear();
+    if(boxes.empty())
+        return;
+    if(leafSize < 1)
+        leafSize = 1;
+
+    items.reserve(boxes.size());
+    centers.reserve(boxes.size());
+    for(int i=0; i<(int)boxes.size(); ++i) {
+        items.push_back(i);
+        centers.push_back(boxes[i].isEmpty() ? SbVec3f(0,0,0) : boxes[i].getCenter());
+    }
+    nodes.reserve(2*boxes.size()/leafSize + 1);
+    buildNode(boxes, 0, (int)items.size(), leafSize);
+    centers.clear();
+    centers.shrink_to_fit();
+}
+
+int SoFCRayPickTree::buildNode(const std::vector<SbBox3f> &boxes, int start, int end, int leafSize) {
+    int index = (int)nodes.size();
+    nodes.emplace_back();
+
+    SbBox3f box, centerBox;
+    for(int i=start; i<end; ++i) {
+        const auto &b = boxes[items[i]];
+        if(b.isEmpty())
+            continue;
+        box.extendBy(b);
+        centerBox.extendBy(centers[items[i]]);
+    }
+    nodes[index].box = box;
+
+    if(end - start <= leafSize || centerBox.isEmpty()) {
+        nodes[index].start = start;
+        nodes[index].count = end - start;
+        return index;
+    }
+
+    // Median split along the longest axis of the group centers
+    float dx, dy, dz;
+    centerBox.getSize(dx, dy, dz);
+    int axis = (dx >= dy && dx >= dz) ? 0 : (dy >= dz ? 1 : 2);
+    int mid = start + (end - start)/2;
+    std::nth_element(items.begin()+start, items.begin()+mid, items.begin()+end,
+        [this, axis](int a, int b) {
+            return centers[a][axis] < centers[b][axis];
+        });
+
+    buildNode(boxes, start, mid, leafSize);
+    int right = buildNode(boxes, mid, end, leafSize);
+    nodes[index].right = right;
+    return index;
+}
+
+void SoFCRayPickTree::query(SoRayPickAction *action, std::vector<int> &res) const {
+    if(nodes.empty())
+        return;
+
+    // Median split keeps the tree balanced, so the stack never holds more
+    // than one entry per level.
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while(top) {
+        const Node &node = nodes[stack[--top]];
+        if(node.box.isEmpty() || !action->intersect(node.box, TRUE))
+            continue;
+        if(node.count) {
+            res.insert(res.end(), items.begin()+node.start, items.begin()+node.start+node.count);
+            continue;
+        }
+        int left = (int)(&node - &nodes[0]) + 1;
+        stack[top++] = node.right;
+        stack[top++] = left;
+    }
+}
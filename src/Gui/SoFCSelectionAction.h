@@ -30,6 +30,7 @@
 #include <Inventor/actions/SoGLRenderAction.h>
 #include <Inventor/actions/SoRayPickAction.h>
 #include <Inventor/SbColor.h>
+#include <Inventor/SbBox3f.h>
 #include <Inventor/SbViewportRegion.h>
 #include <vector>
 #include <memory>
@@ -421,6 +422,57 @@ private:
     bool skipFace;
 };
 
+/** Bounding volume hierarchy for accelerating ray picking
+ *
+ * The tree is built over the bounding boxes of some primitive groups defined
+ * by the owner shape node, e.g. a run of triangles or line segments. The
+ * owner then only needs to generate primitives of those groups found by
+ * query(), instead of the whole shape.
+ */
+class GuiExport SoFCRayPickTree {
+public:
+    /// Clear the tree
+    void clear();
+
+    /// Check if the tree is empty
+    bool isEmpty() const {return nodes.empty();}
+
+    /** Build the tree
+     *
+     * @param boxes: object space bounding boxes of the primitive groups
+     * @param leafSize: maximum number of groups in a leaf node
+     */
+    void build(const std::vector<SbBox3f> &boxes, int leafSize = 4);
+
+    /** Find the primitive groups that may be picked by the given action
+     *
+     * @param action: the ray pick action. The object space ray must have
+     * already been computed, i.e. SoShape::computeObjectSpaceRay().
+     * @param items: output the indices of the groups
+     *
+     * The groups are tested using the full picking view volume of the
+     * action, which includes the pick radius. So it works for picking lines
+     * and points as well.
+     */
+    void query(SoRayPickAction *action, std::vector<int> &items) const;
+
+private:
+    struct Node {
+        SbBox3f box;
+        /// Index of the first group in 'items' if leaf node
+        int start = 0;
+        /// Number of groups if leaf node, or 0 if internal node
+        int count = 0;
+        /// Index of the right child if internal node. The left child is the next node.
+        int right = 0;
+    };
+    int buildNode(const std::vector<SbBox3f> &boxes, int start, int end, int leafSize);
+
+    std::vector<Node> nodes;
+    std::vector<int> items;
+    std::vector<SbVec3f> centers;
+};
+
 } // namespace Gui
 
 
@@ -509,6 +509,45 @@ SoPickedPoint *SoFCUnifiedSelection::getPickedPoint(SoHandleEventAction *action)
     return 0;
 }
 
+void SoFCUnifiedSelection::applySelection(const char *docName,
+        const char *objName, const char *subName, bool add)
+{
+    App::Document* doc = App::GetApplication().getDocument(docName);
+    if (!doc)
+        return;
+    App::DocumentObject* obj = doc->getObject(objName);
+    ViewProvider*vp = Application::Instance->getViewProvider(obj);
+    if (vp && (useNewSelection.getValue()||vp->useNewSelectionModel()) && vp->isSelectable()) {
+        SoDetail *detail = nullptr;
+        detailPath->truncate(0);
+        if(!subName || !subName[0] || vp->getDetailPath(subName,detailPath,true,detail)) {
+            SoSelectionElementAction::Type type = SoSelectionElementAction::None;
+            if (add) {
+                if (detail)
+                    type = SoSelectionElementAction::Append;
+                else
+                    type = SoSelectionElementAction::All;
+            }
+            else {
+                if (detail)
+                    type = SoSelectionElementAction::Remove;
+                else
+                    type = SoSelectionElementAction::None;
+            }
+
+            SoSelectionElementAction selectionAction(type);
+            selectionAction.setColor(this->colorSelection.getValue());
+            selectionAction.setElement(detail);
+            if(detailPath->getLength())
+                selectionAction.apply(detailPath);
+            else
+                selectionAction.apply(vp->getRoot());
+        }
+        detailPath->truncate(0);
+        delete detail;
+    }
+}
+
 void SoFCUnifiedSelection::doAction(SoAction *action)
 {
     SoFCDisplayModeElement::set(action->getState(), this,
@@ -593,40 +632,10 @@ void SoFCUnifiedSelection::doAction(SoAction *action)
                 || selaction->SelChange.Type == SelectionChanges::RmvSelection))
         {
             // selection changes inside the 3d view are handled in handleEvent()
-            App::Document* doc = App::GetApplication().getDocument(selaction->SelChange.pDocName);
-            App::DocumentObject* obj = doc->getObject(selaction->SelChange.pObjectName);
-            ViewProvider*vp = Application::Instance->getViewProvider(obj);
-            if (vp && (useNewSelection.getValue()||vp->useNewSelectionModel()) && vp->isSelectable()) {
-                SoDetail *detail = nullptr;
-                detailPath->truncate(0);
-                if(!selaction->SelChange.pSubName || !selaction->SelChange.pSubName[0] ||
-                    vp->getDetailPath(selaction->SelChange.pSubName,detailPath,true,detail))
-                {
-                    SoSelectionElementAction::Type type = SoSelectionElementAction::None;
-                    if (selaction->SelChange.Type == SelectionChanges::AddSelection) {
-                        if (detail)
-                            type = SoSelectionElementAction::Append;
-                        else
-                            type = SoSelectionElementAction::All;
-                    }
-                    else {
-                        if (detail)
-                            type = SoSelectionElementAction::Remove;
-                        else
-                            type = SoSelectionElementAction::None;
-                    }
-
-                    SoSelectionElementAction selectionAction(type);
-                    selectionAction.setColor(this->colorSelection.getValue());
-                    selectionAction.setElement(detail);
-                    if(detailPath->getLength())
-                        selectionAction.apply(detailPath);
-                    else
-                        selectionAction.apply(vp->getRoot());
-                }
-                detailPath->truncate(0);
-                delete detail;
-            }
+            applySelection(selaction->SelChange.pDocName,
+                           selaction->SelChange.pObjectName,
+                           selaction->SelChange.pSubName,
+                           selaction->SelChange.Type == SelectionChanges::AddSelection);
         }
         else if (selaction->SelChange.Type == SelectionChanges::ClrSelection) {
             SoSelectionElementAction selectionAction(SoSelectionElementAction::None);
@@ -653,6 +662,32 @@ void SoFCUnifiedSelection::doAction(SoAction *action)
                 }
             }
         }
+        else if (selaction->SelChange.Type == SelectionChanges::AddSelections
+                    || selaction->SelChange.Type == SelectionChanges::RmvSelections) {
+            // Only touch the elements of the batch
+            bool add = selaction->SelChange.Type == SelectionChanges::AddSelections;
+            if (selectionMode.getValue() == ON) {
+                for (auto &objT : selaction->SelChange.SubObjects) {
+                    applySelection(objT.getDocumentName().c_str(),
+                                   objT.getObjectName().c_str(),
+                                   objT.getSubName().c_str(),
+                                   add);
+                }
+            }
+            if (useNewSelection.getValue())
+                return;
+            // Old style SoFCSelection nodes only understand per element
+            // messages.
+            for (auto &objT : selaction->SelChange.SubObjects) {
+                SelectionChanges Chng(
+                        add ? SelectionChanges::AddSelection : SelectionChanges::RmvSelection,
+                        objT.getDocumentName(), objT.getObjectName(), objT.getSubName());
+                SoFCSelectionAction cAct(Chng);
+                for (int i=0;i<this->getNumChildren();++i)
+                    cAct.apply(this->getChild(i));
+            }
+            return;
+        }
         if (useNewSelection.getValue())
             return;
     }
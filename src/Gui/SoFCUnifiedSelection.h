@@ -136,6 +136,8 @@ private:
 
     bool setSelection(const std::vector<PickedInfo> &, bool ctrlDown, bool shiftDown, bool altDown);
 
+    void applySelection(const char *docName, const char *objName, const char *subName, bool add);
+
     std::vector<PickedInfo> getPickedList(const SbVec2s &pos,
             const SbViewportRegion &vp, bool singlePick) const;
 
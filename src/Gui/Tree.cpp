@@ -811,6 +811,10 @@ TreeWidget::TreeWidget(const char *name, QWidget* parent)
 
     Instances.insert(this);
 
+    // The tree only schedules a sync with the selection, so batch selection
+    // messages are handled as a whole.
+    setBatchSelection(true);
+
     this->setIconSize(QSize(iconSize(), iconSize()));
 
     if (TreeParams::FontSize() > 0) {
@@ -913,6 +917,7 @@ TreeWidget::TreeWidget(const char *name, QWidget* parent)
 
     connectFinishRestoreDocument = App::GetApplication().signalFinishRestoreDocument.connect(
         [this](const App::Document &doc) {
+            StatusFullUpdate = true;
             for(auto obj : doc.getObjects()) {
                 if(!obj->isValid()) 
                     ChangedObjects[obj].set(TreeWidget::CS_Error);
@@ -3190,6 +3195,7 @@ void TreeWidget::slotChangedViewObject(const Gui::ViewProvider& vp, const App::P
 
 void TreeWidget::slotTouchedObject(const App::DocumentObject &obj) {
     ChangedObjects.insert(std::make_pair(const_cast<App::DocumentObject*>(&obj),0));
+    StatusObjects.insert(const_cast<App::DocumentObject*>(&obj));
     _updateStatus();
 }
 
@@ -3271,6 +3277,23 @@ struct UpdateDisabler {
     }
 };
 
+// The visibility of a child item is controlled by its parent. For children
+// of a plain group, it is controlled by the closest ancestor that is not a
+// plain group (see DocumentObjectItem::testStatus()). So descend through
+// plain groups.
+static void testChildStatus(DocumentObjectItem *item)
+{
+    for(int i=0, count=item->childCount(); i<count; ++i) {
+        auto child = item->child(i);
+        if(child->type() != TreeWidget::ObjectType)
+            continue;
+        auto childItem = static_cast<DocumentObjectItem*>(child);
+        childItem->testStatus(false);
+        if(App::GeoFeatureGroupExtension::isNonGeoGroup(childItem->object()->getObject()))
+            testChildStatus(childItem);
+    }
+}
+
 void TreeWidget::onUpdateStatus(void)
 {
     if(updateBlocked || _DraggingActive
@@ -3289,6 +3312,10 @@ void TreeWidget::onUpdateStatus(void)
             // update logic. For example, a parent object re-created before its
             // children, but the parent's link property already contains all the
             // (detached) children.
+            //
+            // Object status may also change without notification while
+            // undo/redo, so check them all afterwards.
+            StatusFullUpdate = true;
             _updateStatus();
             return;
         }
@@ -3296,6 +3323,9 @@ void TreeWidget::onUpdateStatus(void)
 
     TREE_LOG("begin update status");
 
+    FC_TIME_INIT(t);
+    std::size_t newCount = 0;
+
     UpdateDisabler disabler(*this,updateBlocked);
 
     std::vector<App::DocumentObject*> errors;
@@ -3325,11 +3355,15 @@ void TreeWidget::onUpdateStatus(void)
             if(vpd) {
                 TREE_TRACE("new object " << obj->getNameInDocument());
                 docItem->createNewItem(*vpd);
+                ++newCount;
             }
         }
     }
     NewObjects.clear();
 
+    FC_TIME_LOG(t, "tree create " << newCount << " items");
+    std::size_t changeCount = ChangedObjects.size();
+
     // Update children of changed objects
     for(auto &v : ChangedObjects) {
         auto obj = v.first;
@@ -3355,21 +3389,53 @@ void TreeWidget::onUpdateStatus(void)
             }
         }
 
+        StatusObjects.insert(obj);
         for(auto &data : iter->second) {
             for(auto item : data->items)
                 data->docItem->populateItem(item,true);
         }
+
+        // Children may have been moved to or from root, which may change
+        // their visibility status.
+        if(iter->second.size()) {
+            for(auto child : (*iter->second.begin())->viewObject->getCachedChildren())
+                StatusObjects.insert(child);
+        }
     }
 
     ChangedObjects.clear();
 
-    FC_LOG("update item status");
+    FC_TIME_LOG(t, "tree update " << changeCount << " changed objects");
+    std::size_t statusCount;
     TimingInit();
-    for (auto pos = DocumentMap.begin();pos!=DocumentMap.end();++pos) {
-        pos->second->testStatus();
+    if(StatusFullUpdate) {
+        FC_LOG("update all item status");
+        StatusFullUpdate = false;
+        statusCount = ObjectTable.size();
+        for (auto pos = DocumentMap.begin();pos!=DocumentMap.end();++pos) {
+            pos->second->testStatus();
+        }
+    } else {
+        FC_LOG("update item status");
+        statusCount = StatusObjects.size();
+        // Besides the items of the changed objects, check the child items
+        // whose visibility may be controlled by them.
+        for(auto obj : StatusObjects) {
+            auto iter = ObjectTable.find(obj);
+            if(iter == ObjectTable.end())
+                continue;
+            for(auto &data : iter->second) {
+                data->testStatus();
+                for(auto item : data->items)
+                    testChildStatus(item);
+            }
+        }
     }
+    StatusObjects.clear();
     TimingPrint();
 
+    FC_TIME_LOG(t, "tree check status of " << statusCount << " objects");
+
     // Checking for just restored documents
     for(auto &v : DocumentMap) {
         auto docItem = v.second;
@@ -3921,6 +3987,8 @@ void TreeWidget::onSelectionChanged(const SelectionChanges& msg)
     }
     case SelectionChanges::AddSelection:
     case SelectionChanges::RmvSelection:
+    case SelectionChanges::AddSelections:
+    case SelectionChanges::RmvSelections:
     case SelectionChanges::SetSelection: {
         int timeout = TreeParams::Instance()->SelectionTimeout();
         if(timeout<=0)
@@ -4734,6 +4802,7 @@ void TreeWidget::slotDeleteObject(const Gui::ViewProviderDocumentObject& view) {
 void TreeWidget::_slotDeleteObject(const Gui::ViewProviderDocumentObject& view, DocumentItem *deletingDoc)
 {
     auto obj = view.getObject();
+    StatusObjects.erase(obj);
     auto itEntry = ObjectTable.find(obj);
     if(itEntry == ObjectTable.end())
         return;
@@ -4858,14 +4927,37 @@ void DocumentItem::populateItem(DocumentObjectItem *item, bool refresh, bool del
     bool checkHidden = !showHidden();
     bool updated = false;
 
+    // Child items of objects no longer claimed are moved to the end as soon as
+    // they are encountered, and deleted there after the loop below. Otherwise,
+    // removing a child near the front will cause all following items to be
+    // moved one by one, which is quadratic for objects with many children.
+    std::unordered_set<App::DocumentObject*> claimed(children.begin(), children.end());
+    int staleCount = 0;
+
     int i=-1;
     // iterate through the claimed children, and try to synchronize them with the 
     // children tree item with the same order of appearance. 
-    int childCount = item->childCount();
     for(auto child : item->myData->viewObject->getCachedChildren()) {
 
         ++i; // the current index of the claimed child
 
+        int childCount = item->childCount() - staleCount;
+        while(i < childCount) {
+            QTreeWidgetItem *ci = item->child(i);
+            if (ci->type() != TreeWidget::ObjectType)
+                break;
+            DocumentObjectItem *childItem = static_cast<DocumentObjectItem*>(ci);
+            if (claimed.count(childItem->object()->getObject()))
+                break;
+            childItem->setHighlight(false);
+            item->removeChild(childItem);
+            childItem->selected = 0;
+            childItem->mySubs.clear();
+            item->addChild(childItem);
+            ++staleCount;
+            --childCount;
+        }
+
         bool found = false;
         for (int j=i;j<childCount;++j) {
             QTreeWidgetItem *ci = item->child(j);
@@ -5049,6 +5141,7 @@ void TreeWidget::slotChangeObject(
     if(itEntry == ObjectTable.end() || itEntry->second.empty())
         return;
 
+    StatusObjects.insert(obj);
     _updateStatus();
 
     // Let's not waste time on the newly added Visibility property in
@@ -5312,8 +5405,9 @@ void DocumentItem::slotRecomputed(const App::Document &, const std::vector<App::
     for(auto obj : objs) {
         if(!obj->isValid()) 
             tree->ChangedObjects[obj].set(TreeWidget::CS_Error);
+        tree->StatusObjects.insert(obj);
     }
-    if(tree->ChangedObjects.size())
+    if(tree->ChangedObjects.size() || tree->StatusObjects.size())
         tree->_updateStatus();
 }
 
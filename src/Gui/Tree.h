@@ -25,6 +25,7 @@
 #define GUI_TREE_H
 
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <QTreeWidget>
 #include <QTime>
@@ -291,6 +292,11 @@ private:
     };
     std::unordered_map<App::DocumentObject*,std::bitset<32> > ChangedObjects;
 
+    /// Objects whose item status (icon) may be outdated
+    std::unordered_set<App::DocumentObject*> StatusObjects;
+    /// Whether to check the item status of all objects on next update
+    bool StatusFullUpdate = true;
+
     std::unordered_map<std::string,std::vector<long> > NewObjects;
 
     static std::set<TreeWidget*> Instances;
@@ -509,6 +509,7 @@ void View3DInventorViewer::init()
 {
     _pimpl.reset(new Private(this));
     _pimpl->timer.setSingleShot(true);
+    setBatchSelection(true);
     connect(&_pimpl->timer,SIGNAL(timeout()),this,SLOT(redrawShadow()));
 
     static bool _cacheModeInited;
@@ -1418,6 +1419,15 @@ void View3DInventorViewer::onSelectionChanged(const SelectionChanges &_Reason)
     case SelectionChanges::ClrSelection:
         checkGroupOnTop(Reason);
         break;
+    case SelectionChanges::AddSelections:
+    case SelectionChanges::RmvSelections:
+        for(auto &objT : Reason.SubObjects) {
+            checkGroupOnTop(SelectionChanges(
+                        Reason.Type == SelectionChanges::AddSelections ?
+                            SelectionChanges::AddSelection : SelectionChanges::RmvSelection,
+                        objT.getDocumentName(), objT.getObjectName(), objT.getSubName()));
+        }
+        break;
     default:
         return;
     }
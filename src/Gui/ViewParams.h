@@ -269,6 +269,10 @@ public:
         QT_TRANSLATE_NOOP("ViewParams","Show object on top will editing its color."))\
     FC_VIEW_PARAM(ColorRecompute, bool, Bool, true, \
         QT_TRANSLATE_NOOP("ViewParams","Recompute affected object(s) after editing color."))\
+    FC_VIEW_PARAM(SceneMemoryBudget, int, Int, 0, \
+        QT_TRANSLATE_NOOP("ViewParams","Scene graph memory budget per document in MB, 0 to disable. When exceeded\n"\
+                                       "after recompute, the visual of hidden objects is released, and rebuilt\n"\
+                                       "when shown again."))\
 
 #undef FC_VIEW_PARAM
 #define FC_VIEW_PARAM(_name,_ctype,_type,_def,_doc) \
@@ -118,6 +118,12 @@ public:
     //@{
     virtual void forceUpdate(bool enable = true) {(void)enable;}
     virtual bool isUpdateForced() const {return false;}
+    /** Release the visual of a hidden object to save memory
+     *
+     * @return Return true if released. The view provider is expected to
+     * rebuild the visual when shown or forced to update.
+     */
+    virtual bool releaseVisual() {return false;}
     //@}
 
     /** @name Restoring view provider from document load */
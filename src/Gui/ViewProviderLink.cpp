@@ -40,6 +40,10 @@
 # include <Inventor/nodes/SoSurroundScale.h>
 # include <Inventor/nodes/SoCube.h>
 # include <Inventor/sensors/SoNodeSensor.h>
+# include <Inventor/nodes/SoCoordinate3.h>
+# include <Inventor/nodes/SoNormal.h>
+# include <Inventor/nodes/SoIndexedShape.h>
+# include <Inventor/nodes/SoVertexProperty.h>
 #endif
 #include <cctype>
 #include <atomic>
@@ -1036,6 +1040,137 @@ void LinkView::setInvalid(void) {
         delete this;
 }
 
+LinkView::Statistics &LinkView::Statistics::operator+=(const Statistics &other) {
+    nodeCount += other.nodeCount;
+    instanceCount += other.instanceCount;
+    coordinateBytes += other.coordinateBytes;
+    indexBytes += other.indexBytes;
+    instanceBytes += other.instanceBytes;
+    return *this;
+}
+
+static std::pair<std::size_t, std::size_t>
+_collectStatistics(SoNode *node, LinkView::Statistics &stats, LinkView::NodeStatMap &visited)
+{
+    auto res = visited.emplace(node, std::pair<std::size_t, std::size_t>());
+    if(!res.second)
+        return res.first->second;
+
+    // Reference stays valid on rehash. Inserting before recursion also guards
+    // against cyclic scene graph.
+    auto &entry = res.first->second;
+
+    std::size_t coordBytes = 0;
+    std::size_t indexBytes = 0;
+    if(node->isOfType(SoCoordinate3::getClassTypeId()))
+        coordBytes = static_cast<SoCoordinate3*>(node)->point.getNum() * sizeof(SbVec3f);
+    else if(node->isOfType(SoNormal::getClassTypeId()))
+        coordBytes = static_cast<SoNormal*>(node)->vector.getNum() * sizeof(SbVec3f);
+    else if(node->isOfType(SoVertexProperty::getClassTypeId())) {
+        auto vprop = static_cast<SoVertexProperty*>(node);
+        coordBytes = (vprop->vertex.getNum() + vprop->normal.getNum()) * sizeof(SbVec3f)
+                   + vprop->texCoord.getNum() * sizeof(SbVec2f)
+                   + vprop->orderedRGBA.getNum() * sizeof(uint32_t);
+    } else if(node->isOfType(SoIndexedShape::getClassTypeId())) {
+        auto shape = static_cast<SoIndexedShape*>(node);
+        indexBytes = (shape->coordIndex.getNum()
+                        + shape->normalIndex.getNum()
+                        + shape->materialIndex.getNum()
+                        + shape->textureCoordIndex.getNum()) * sizeof(int32_t);
+    }
+
+    ++stats.nodeCount;
+    stats.coordinateBytes += coordBytes;
+    stats.indexBytes += indexBytes;
+
+    std::pair<std::size_t, std::size_t> total(1, coordBytes + indexBytes);
+    // This covers groups and node kits
+    auto children = node->getChildren();
+    if(children) {
+        for(int i=0, count=children->getLength(); i<count; ++i) {
+            auto r = _collectStatistics((*children)[i], stats, visited);
+            total.first += r.first;
+            total.second += r.second;
+        }
+    }
+    entry = total;
+    return total;
+}
+
+void LinkView::collectStatistics(SoNode *node, Statistics &stats, NodeStatMap &visited) {
+    if(!node)
+        return;
+    auto res = _collectStatistics(node, stats, visited);
+    stats.instanceCount += res.first;
+    stats.instanceBytes += res.second;
+}
+
+LinkView::Statistics LinkView::getDocumentStatistics(Gui::Document *doc,
+        std::vector<std::pair<ViewProviderDocumentObject*, Statistics> > *perObject)
+{
+    Statistics stats;
+    if(!doc)
+        return stats;
+    NodeStatMap visited;
+    for(auto vp : doc->getViewProvidersOfType(ViewProviderDocumentObject::getClassTypeId())) {
+        auto vpd = static_cast<ViewProviderDocumentObject*>(vp);
+        collectStatistics(vpd->getRoot(), stats, visited);
+        if(perObject) {
+            NodeStatMap objVisited;
+            perObject->emplace_back(vpd, Statistics());
+            collectStatistics(vpd->getRoot(), perObject->back().second, objVisited);
+        }
+    }
+    return stats;
+}
+
+std::size_t LinkView::applyMemoryBudget(Gui::Document *doc, std::size_t budget) {
+    if(!doc)
+        return 0;
+
+    // Collect with a shared map, so that the bytes of a shared node are only
+    // attributed to the first view provider. It does not matter much, because
+    // a view provider whose nodes are shared by some link is update forced,
+    // and therefore not released.
+    Statistics total;
+    NodeStatMap visited;
+    std::vector<std::pair<std::size_t, ViewProviderDocumentObject*> > candidates;
+    for(auto vp : doc->getViewProvidersOfType(ViewProviderDocumentObject::getClassTypeId())) {
+        auto vpd = static_cast<ViewProviderDocumentObject*>(vp);
+        Statistics stats;
+        collectStatistics(vpd->getRoot(), stats, visited);
+        total += stats;
+        if(stats.bytes() && !vpd->isShow() && !vpd->isUpdateForced())
+            candidates.emplace_back(stats.bytes(), vpd);
+    }
+
+    std::size_t bytes = total.bytes();
+    if(bytes <= budget)
+        return 0;
+
+    std::sort(candidates.begin(), candidates.end(),
+        [](const std::pair<std::size_t, ViewProviderDocumentObject*> &a,
+           const std::pair<std::size_t, ViewProviderDocumentObject*> &b)
+        {
+            return a.first > b.first;
+        });
+
+    std::size_t released = 0;
+    for(auto &v : candidates) {
+        if(bytes <= budget)
+            break;
+        if(!v.second->releaseVisual())
+            continue;
+        FC_LOG("release visual of " << v.second->getObject()->getFullName() << ", " << v.first << " bytes");
+        released += v.first;
+        bytes -= std::min(bytes, v.first);
+    }
+    if(bytes > budget)
+        FC_WARN("Scene memory " << bytes << " bytes of document " << doc->getDocument()->getName()
+                << " exceeds budget " << budget << " bytes");
+    return released;
+}
+
 Base::BoundBox3d LinkView::getBoundBox(ViewProviderDocumentObject *vpd) const {
     if(!vpd) {
         if(!linkOwner || !linkOwner->isLinked())
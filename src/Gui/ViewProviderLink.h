@@ -167,6 +167,69 @@ public:
 
     void setInvalid();
 
+    /** @name Scene graph statistics
+     *
+     * Link shares the Coin nodes of the linked object among its instances.
+     * The following functions report how much memory the scene graph uses,
+     * and how much would have been used without sharing.
+     */
+    //@{
+    struct Statistics {
+        /// Number of distinct nodes
+        std::size_t nodeCount = 0;
+        /// Number of nodes when counting each instance of a shared node
+        std::size_t instanceCount = 0;
+        /// Bytes of coordinate, normal, texture coordinate and color buffers of distinct nodes
+        std::size_t coordinateBytes = 0;
+        /// Bytes of index buffers of distinct nodes
+        std::size_t indexBytes = 0;
+        /// Buffer bytes when counting each instance of a shared node
+        std::size_t instanceBytes = 0;
+
+        std::size_t bytes() const {return coordinateBytes + indexBytes;}
+        double sharingRatio() const {
+            return nodeCount ? double(instanceCount)/nodeCount : 1.0;
+        }
+        Statistics &operator+=(const Statistics &other);
+    };
+
+    /// Map from visited node to its subtree instance node count and bytes
+    typedef std::unordered_map<SoNode*, std::pair<std::size_t,std::size_t> > NodeStatMap;
+
+    /** Collect scene graph statistics
+     *
+     * @param node: the root node
+     * @param stats: output statistics, accumulated
+     * @param visited: nodes that have already been counted. Distinct counts
+     * only include nodes not found in here. Pass the same map for multiple
+     * roots to obtain the statistics of the combined scene.
+     */
+    static void collectStatistics(SoNode *node, Statistics &stats, NodeStatMap &visited);
+
+    /** Collect scene graph statistics of a document
+     *
+     * @param doc: the document
+     * @param perObject: optional output of statistics of each view provider,
+     * counted as if it were the only one in the scene
+     *
+     * @return Return the statistics of the combined document scene
+     */
+    static Statistics getDocumentStatistics(Gui::Document *doc,
+            std::vector<std::pair<ViewProviderDocumentObject*, Statistics> > *perObject=nullptr);
+
+    /** Release the visual of hidden objects until the scene memory is within budget
+     *
+     * @param doc: the document
+     * @param budget: memory budget in bytes
+     *
+     * Larger objects are released first. The visual of a released object is
+     * rebuilt on demand when shown, see ViewProviderDocumentObject::releaseVisual().
+     *
+     * @return Return the released bytes
+     */
+    static std::size_t applyMemoryBudget(Gui::Document *doc, std::size_t budget);
+    //@}
+
 protected:
     void replaceLinkedRoot(SoSeparator *);
     void resetRoot();
@@ -25,15 +25,23 @@
 
 #ifndef _PreComp_
 # include <Python.h>
+# include <iterator>
 # include <vtkPolyData.h>
 # include <vtkStructuredGrid.h>
 # include <vtkRectilinearGrid.h>
 # include <vtkUnstructuredGrid.h>
 # include <vtkUniformGrid.h>
+# include <vtkImageData.h>
+# include <vtkStructuredPoints.h>
 # include <vtkCompositeDataSet.h>
 # include <vtkMultiBlockDataSet.h>
 # include <vtkMultiPieceDataSet.h>
 # include <vtkXMLDataSetWriter.h>
+# include <vtkXMLPolyDataWriter.h>
+# include <vtkXMLStructuredGridWriter.h>
+# include <vtkXMLRectilinearGridWriter.h>
+# include <vtkXMLUnstructuredGridWriter.h>
+# include <vtkXMLImageDataWriter.h>
 # include <vtkXMLPolyDataReader.h>
 # include <vtkXMLStructuredGridReader.h>
 # include <vtkXMLUnstructuredGridReader.h>
@@ -41,10 +49,15 @@
 # include <vtkXMLImageDataReader.h>
 #endif
 
+#include <vtkVersion.h>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+
 #include <Base/FileInfo.h>
 #include <Base/Console.h>
 #include <Base/Writer.h>
 #include <Base/Reader.h>
+#include <Base/Parameter.h>
 #include <App/Application.h>
 #include <App/DocumentObject.h>
 
@@ -54,6 +67,8 @@
 
 #endif
 
+FC_LOG_LEVEL_INIT("Fem",true,true)
+
 using namespace Fem;
 
 TYPESYSTEM_SOURCE(Fem::PropertyPostDataObject , App::Property)
@@ -146,6 +161,12 @@ void PropertyPostDataObject::createDataObjectByExternalType(vtkSmartPointer< vtk
         case VTK_UNIFORM_GRID:
             m_dataObject = vtkSmartPointer<vtkUniformGrid>::New();
             break;
+        case VTK_IMAGE_DATA:
+            m_dataObject = vtkSmartPointer<vtkImageData>::New();
+            break;
+        case VTK_STRUCTURED_POINTS:
+            m_dataObject = vtkSmartPointer<vtkStructuredPoints>::New();
+            break;
         case VTK_COMPOSITE_DATA_SET:
             m_dataObject = vtkCompositeDataSet::New();
             break;
@@ -214,6 +235,8 @@ void PropertyPostDataObject::Save (Base::Writer &writer) const
             extension += "vtu";
             break;
         case VTK_UNIFORM_GRID:
+        case VTK_IMAGE_DATA:
+        case VTK_STRUCTURED_POINTS:
             extension += "vti"; //image data
             break;
         //TODO:multi-datasets use multiple files, this needs to be implemented specially
@@ -273,43 +296,101 @@ void PropertyPostDataObject::save(std::ostream &s, Base::Writer &writer) const
     if (!m_dataObject)
         return;
 
-    Base::FileInfo fi(App::Application::getTempFileName(), true);
+    FC_TIME_INIT(t);
 
-    vtkSmartPointer<vtkXMLDataSetWriter> xmlWriter = vtkSmartPointer<vtkXMLDataSetWriter>::New();
+    // Use the concrete writer of the data set type, so that the data can be
+    // written into memory directly without going through a temporary file.
+    // The generic vtkXMLDataSetWriter does not pass WriteToOutputString on to
+    // the writer it creates internally (before VTK 9), so any other type still
+    // goes through a temporary file.
+    vtkSmartPointer<vtkXMLWriter> xmlWriter;
+    std::unique_ptr<Base::FileInfo> tmpFile;
+    switch( m_dataObject->GetDataObjectType() ) {
+        case VTK_POLY_DATA:
+            xmlWriter = vtkSmartPointer<vtkXMLPolyDataWriter>::New();
+            break;
+        case VTK_STRUCTURED_GRID:
+            xmlWriter = vtkSmartPointer<vtkXMLStructuredGridWriter>::New();
+            break;
+        case VTK_RECTILINEAR_GRID:
+            xmlWriter = vtkSmartPointer<vtkXMLRectilinearGridWriter>::New();
+            break;
+        case VTK_UNSTRUCTURED_GRID:
+            xmlWriter = vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
+            break;
+        case VTK_UNIFORM_GRID:
+        case VTK_IMAGE_DATA:
+        case VTK_STRUCTURED_POINTS:
+            xmlWriter = vtkSmartPointer<vtkXMLImageDataWriter>::New();
+            break;
+        default:
+            xmlWriter = vtkSmartPointer<vtkXMLDataSetWriter>::New();
+            tmpFile.reset(new Base::FileInfo(App::Application::getTempFileName(), true));
+            break;
+    }
     xmlWriter->SetInputDataObject(m_dataObject);
-    xmlWriter->SetFileName(fi.filePath().c_str());
-    if(writer.isPreferBinary())
-        xmlWriter->SetDataModeToBinary();
+    if(tmpFile)
+        xmlWriter->SetFileName(tmpFile->filePath().c_str());
+    else
+        xmlWriter->WriteToOutputStringOn();
+    if(writer.isPreferBinary()) {
+        ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+                "User parameter:BaseApp/Preferences/Mod/Fem/General");
+        // Raw appended data is only possible when writing into its own file,
+        // i.e. not inside a CDATA section of the document XML.
+        if(writer.isForceXML() <= 1 && hGrp->GetBool("ResultAppendedRawData", false)) {
+            xmlWriter->SetDataModeToAppended();
+            xmlWriter->EncodeAppendedDataOff();
+        }
+        else
+            xmlWriter->SetDataModeToBinary();
+#if (VTK_MAJOR_VERSION > 8) || (VTK_MAJOR_VERSION == 8 && VTK_MINOR_VERSION >= 2)
+        // -1 means keeping the VTK default compression
+        long level = hGrp->GetInt("ResultCompressionLevel", -1);
+        if(level == 0)
+            xmlWriter->SetCompressorTypeToNone();
+        else if(level > 0)
+            xmlWriter->SetCompressionLevel(std::min(9L, level));
+#endif
+    }
     else
         xmlWriter->SetDataModeToAscii();
 
     if ( xmlWriter->Write() != 1 ) {
-        // Note: Do NOT throw an exception here because if the tmp. file could
-        // not be created we should not abort.
+        // Note: Do NOT throw an exception here because if the data could not
+        // be written we should not abort.
         // We only print an error message but continue writing the next files to the
         // stream...
         App::PropertyContainer* father = this->getContainer();
         if (father && father->isDerivedFrom(App::DocumentObject::getClassTypeId())) {
             App::DocumentObject* obj = static_cast<App::DocumentObject*>(father);
-            Base::Console().Error("Dataset of '%s' cannot be written to vtk file '%s'\n",
-                obj->Label.getValue(),fi.filePath().c_str());
+            Base::Console().Error("Dataset of '%s' cannot be written to vtk format\n",
+                obj->Label.getValue());
         }
         else {
-            Base::Console().Error("Cannot save vtk file '%s'\n", fi.filePath().c_str());
+            Base::Console().Error("Cannot save vtk data\n");
         }
 
-        std::stringstream ss;
-        ss << "Cannot save vtk file '" << fi.filePath() << "'";
-        writer.addError(ss.str());
+        writer.addError("Cannot save vtk data");
+        return;
     }
 
-    Base::ifstream file(fi, std::ios::in | std::ios::binary);
-    if (file){
-        std::streambuf* buf = file.rdbuf();
-        s << buf;
+    std::size_t size;
+    if(tmpFile) {
+        Base::ifstream file(*tmpFile, std::ios::in | std::ios::binary);
+        if (file)
+            s << file.rdbuf();
+        size = tmpFile->size();
+    }
+    else {
+        // vtkXMLWriter only hands out its output string by value, this is the
+        // single copy of the data on its way into the stream.
+        const std::string data = xmlWriter->GetOutputString();
+        s.write(data.c_str(), data.size());
+        size = data.size();
     }
 
-    file.close();
+    FC_TIME_LOG(t, "save vtk data " << size << " bytes");
 }
 
 void PropertyPostDataObject::RestoreDocFile(Base::Reader &reader)
@@ -320,22 +401,16 @@ void PropertyPostDataObject::RestoreDocFile(Base::Reader &reader)
 
 void PropertyPostDataObject::restore(std::istream &reader, const std::string &extension) {
 
-    // create a temporary file and copy the content from the zip stream
-    Base::FileInfo fi(App::Application::getTempFileName());
-
-    // read in the ASCII file and write back to the file stream
-    Base::ofstream file(fi, std::ios::out | std::ios::binary);
-    unsigned long ulSize = 0;
-    if (reader) {
-        std::streambuf* buf = file.rdbuf();
-        reader >> buf;
-        file.flush();
-        ulSize = buf->pubseekoff(0, std::ios::cur, std::ios::in);
-    }
-    file.close();
+    FC_TIME_INIT(t);
 
-    // Read the data from the temp file
-    if (ulSize > 0) {
+    // read the whole content into memory, and let the vtk reader parse it from there.
+    // The reader may seek, so the input stream can't be handed over directly.
+    std::string data;
+    if (reader)
+        data.assign(std::istreambuf_iterator<char>(reader), std::istreambuf_iterator<char>());
+
+    // Read the data from the buffer
+    if (data.size() > 0) {
         //TODO: read in of composite data structures need to be coded, including replace of "GetOutputAsDataSet()"
         vtkSmartPointer<vtkXMLReader> xmlReader;
         if(extension == "vtp")
@@ -348,23 +423,32 @@ void PropertyPostDataObject::restore(std::istream &reader, const std::string &ex
             xmlReader = vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
         else if (extension == "vti")
             xmlReader = vtkSmartPointer<vtkXMLImageDataReader>::New();
+        else {
+            Base::Console().Error("Unsupported dataset type '%s'\n", extension.c_str());
+            return;
+        }
 
-        xmlReader->SetFileName(fi.filePath().c_str());
+        // SetInputString() would copy the buffer twice, first into the reader
+        // and then into its string stream. Read from a stream over our buffer instead.
+        typedef boost::iostreams::basic_array_source<char> Device;
+        boost::iostreams::stream<Device> stream(data.c_str(), data.size());
+        xmlReader->SetStream(&stream);
         xmlReader->Update();
+        xmlReader->SetStream(nullptr);
 
         if (!xmlReader->GetOutputAsDataSet()) {
-            // Note: Do NOT throw an exception here because if the tmp. created file could
+            // Note: Do NOT throw an exception here because if the data could
             // not be read it's NOT an indication for an invalid input stream 'reader'.
             // We only print an error message but continue reading the next files from the
             // stream...
             App::PropertyContainer* father = this->getContainer();
             if (father && father->isDerivedFrom(App::DocumentObject::getClassTypeId())) {
                 App::DocumentObject* obj = static_cast<App::DocumentObject*>(father);
-                Base::Console().Error("Dataset file '%s' with data of '%s' seems to be empty\n",
-                    fi.filePath().c_str(),obj->Label.getValue());
+                Base::Console().Error("Dataset with data of '%s' seems to be empty\n",
+                    obj->Label.getValue());
             }
             else {
-                Base::Console().Warning("Loaded Dataset file '%s' seems to be empty\n", fi.filePath().c_str());
+                Base::Console().Warning("Loaded Dataset seems to be empty\n");
             }
         }
         else {
@@ -375,6 +459,5 @@ void PropertyPostDataObject::restore(std::istream &reader, const std::string &ex
         }
     }
 
-    // delete the temp file
-    fi.deleteFile();
+    FC_TIME_LOG(t, "restore vtk data " << data.size() << " bytes");
 }
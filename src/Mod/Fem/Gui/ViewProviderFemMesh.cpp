@@ -70,6 +70,11 @@
 #include <Base/TimeInfo.h>
 #include <Base/BoundBox.h>
 
+#include <unordered_map>
+#include <QThread>
+#include <QtConcurrentMap>
+#include <boost/functional/hash.hpp>
+
 
 
 using namespace FemGui;
@@ -87,14 +92,14 @@ struct FemFace
         return Base::Vector3d(Nodes[0]->X(),Nodes[0]->Y(),Nodes[0]->Z());
     }
 
-    Base::Vector3d set(short size,const SMDS_MeshElement* element,unsigned short id, short faceNo,
+    void set(short size,const SMDS_MeshElement* element,unsigned long id, short faceNo,
         const SMDS_MeshNode* n1,const SMDS_MeshNode* n2,const SMDS_MeshNode* n3,const SMDS_MeshNode* n4=0,
         const SMDS_MeshNode* n5=0,const SMDS_MeshNode* n6=0,const SMDS_MeshNode* n7=0,const SMDS_MeshNode* n8=0);
 
     bool isSameFace (FemFace &face);
 };
 
-Base::Vector3d FemFace::set(short size,const SMDS_MeshElement* element,unsigned short id,short faceNo,
+void FemFace::set(short size,const SMDS_MeshElement* element,unsigned long id,short faceNo,
                             const SMDS_MeshNode* n1,const SMDS_MeshNode* n2,const SMDS_MeshNode* n3,const SMDS_MeshNode* n4,
                             const SMDS_MeshNode* n5,const SMDS_MeshNode* n6,const SMDS_MeshNode* n7,const SMDS_MeshNode* n8)
 {
@@ -131,8 +136,6 @@ Base::Vector3d FemFace::set(short size,const SMDS_MeshElement* element,unsigned
             }
         }
     }
-
-    return Base::Vector3d(Nodes[0]->X(),Nodes[0]->Y(),Nodes[0]->Z());
 }
 
 class FemFaceGridItem : public std::vector<FemFace*>{
@@ -140,6 +143,20 @@ public:
     //FemFaceGridItem(void){reserve(200);}
 };
 
+// Hash and compare faces by their (sorted) nodes
+struct FemFaceHasher {
+    std::size_t operator()(const FemFace *face) const {
+        std::size_t seed = face->Size;
+        for(int i=0; i<8 && face->Nodes[i]; ++i)
+            boost::hash_combine(seed, face->Nodes[i]);
+        return seed;
+    }
+    bool operator()(const FemFace *a, const FemFace *b) const {
+        return a->Size == b->Size
+            && std::equal(a->Nodes, a->Nodes+8, b->Nodes);
+    }
+};
+
 bool FemFace::isSameFace (FemFace &face)
 {
     // the same element can not have the same face
@@ -527,30 +544,38 @@ PyObject * ViewProviderFemMesh::getPyObject()
 
 void ViewProviderFemMesh::setColorByNodeId(const std::map<long,App::Color> &NodeColorMap)
 {
+    if(NodeColorMap.empty())
+        return;
+
+    long startId = NodeColorMap.begin()->first;
     long endId = (--NodeColorMap.end())->first;
 
-    std::vector<App::Color> colorVec(endId+1,App::Color(0,1,0));
+    std::vector<App::Color> colorVec(endId-startId+1,App::Color(0,1,0));
     for(std::map<long,App::Color>::const_iterator it=NodeColorMap.begin();it!=NodeColorMap.end();++it)
-        colorVec[it->first] = it->second;
+        colorVec[it->first-startId] = it->second;
 
-    setColorByNodeIdHelper(colorVec);
+    setColorByNodeId(colorVec.data(),colorVec.size(),startId);
 
 }
 void ViewProviderFemMesh::setColorByNodeId(const std::vector<long> &NodeIds,const std::vector<App::Color> &NodeColors)
 {
+    if(NodeIds.empty())
+        return;
 
-    long endId = *(std::max_element(NodeIds.begin(), NodeIds.end()));
+    auto range = std::minmax_element(NodeIds.begin(), NodeIds.end());
+    long startId = *range.first;
+    long endId = *range.second;
 
-    std::vector<App::Color> colorVec(endId+1,App::Color(0,1,0));
+    std::vector<App::Color> colorVec(endId-startId+1,App::Color(0,1,0));
     long i=0;
     for(std::vector<long>::const_iterator it=NodeIds.begin();it!=NodeIds.end();++it,i++)
-        colorVec[*it] = NodeColors[i];
+        colorVec[*it-startId] = NodeColors[i];
 
-    setColorByNodeIdHelper(colorVec);
+    setColorByNodeId(colorVec.data(),colorVec.size(),startId);
 
 }
 
-void ViewProviderFemMesh::setColorByNodeIdHelper(const std::vector<App::Color> &colorVec)
+void ViewProviderFemMesh::setColorByNodeId(const App::Color *NodeColors, long count, long startId)
 {
     pcMatBinding->value = SoMaterialBinding::PER_VERTEX_INDEXED;
 
@@ -558,11 +583,18 @@ void ViewProviderFemMesh::setColorByNodeIdHelper(const std::vector<App::Color> &
     pcShapeMaterial->diffuseColor.setNum(vNodeElementIdx.size());
     SbColor* colors = pcShapeMaterial->diffuseColor.startEditing();
 
+    // only the nodes that are actually shown are looked up in the array
     long i=0;
     for(std::vector<unsigned long>::const_iterator it=vNodeElementIdx.begin()
             ;it!=vNodeElementIdx.end()
             ;++it,i++)
-       colors[i] = SbColor(colorVec[*it].r,colorVec[*it].g,colorVec[*it].b);
+    {
+        long idx = static_cast<long>(*it) - startId;
+        if(idx < 0 || idx >= count)
+            colors[i] = SbColor(0,1,0);
+        else
+            colors[i] = SbColor(NodeColors[idx].r,NodeColors[idx].g,NodeColors[idx].b);
+    }
 
     pcShapeMaterial->diffuseColor.finishEditing();
 }
@@ -603,8 +635,27 @@ void ViewProviderFemMesh::setDisplacementByNodeId(const std::vector<long> &NodeI
     setDisplacementByNodeIdHelper(vecVec,startId);
 }
 
+void ViewProviderFemMesh::setDisplacementByNodeId(const double *NodeDisps, long count, long startId)
+{
+    // remove the displacement of the previous frame before replacing it
+    applyDisplacementToNodes(0.0);
+
+    // pick the displacement of the shown nodes directly out of the array
+    DisplacementVector.resize(vNodeElementIdx.size());
+    int i=0;
+    for(std::vector<unsigned long>::const_iterator it=vNodeElementIdx.begin();it!=vNodeElementIdx.end();++it,i++) {
+        long idx = static_cast<long>(*it) - startId;
+        if(idx < 0 || idx >= count)
+            DisplacementVector[i] = Base::Vector3d();
+        else
+            DisplacementVector[i] = Base::Vector3d(NodeDisps[idx*3],NodeDisps[idx*3+1],NodeDisps[idx*3+2]);
+    }
+    applyDisplacementToNodes(1.0);
+}
+
 void ViewProviderFemMesh::setDisplacementByNodeIdHelper(const std::vector<Base::Vector3d>& DispVector,long startId)
 {
+    applyDisplacementToNodes(0.0);
     DisplacementVector.resize(vNodeElementIdx.size());
     int i=0;
     for(std::vector<unsigned long>::const_iterator it=vNodeElementIdx.begin();it!=vNodeElementIdx.end();++it,i++)
@@ -649,6 +700,23 @@ void ViewProviderFemMesh::applyDisplacementToNodes(double factor)
 }
 
 void ViewProviderFemMesh::setColorByElementId(const std::map<long,App::Color> &ElementColorMap)
+{
+    if(ElementColorMap.empty()) {
+        setColorByElementId(0,0,0);
+        return;
+    }
+
+    long startId = ElementColorMap.begin()->first;
+    long endId = (--ElementColorMap.end())->first;
+
+    std::vector<App::Color> colorVec(endId-startId+1,App::Color(0,1,0));
+    for(std::map<long,App::Color>::const_iterator it=ElementColorMap.begin();it!=ElementColorMap.end();++it)
+        colorVec[it->first-startId] = it->second;
+
+    setColorByElementId(colorVec.data(),colorVec.size(),startId);
+}
+
+void ViewProviderFemMesh::setColorByElementId(const App::Color *ElementColors, long count, long startId)
 {
     pcMatBinding->value = SoMaterialBinding::PER_FACE ;
 
@@ -660,12 +728,11 @@ void ViewProviderFemMesh::setColorByElementId(const std::map<long,App::Color> &E
     for(std::vector<unsigned long>::const_iterator it=vFaceElementIdx.begin()
             ;it!=vFaceElementIdx.end()
             ;++it,i++){
-        unsigned long ElemIdx = ((*it)>>3);
-        const std::map<long,App::Color>::const_iterator pos = ElementColorMap.find(ElemIdx);
-        if(pos == ElementColorMap.end())
+        long idx = static_cast<long>((*it)>>3) - startId;
+        if(idx < 0 || idx >= count)
             colors[i] = SbColor(0,1,0);
         else
-            colors[i] = SbColor(pos->second.r,pos->second.g,pos->second.b);
+            colors[i] = SbColor(ElementColors[idx].r,ElementColors[idx].g,ElementColors[idx].b);
     }
 
     pcShapeMaterial->diffuseColor.finishEditing();
@@ -784,7 +851,6 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
     std::vector<FemFace> facesHelper(numTries);
 
     Base::Console().Log("    %f: Start build up %i face helper\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()),facesHelper.size());
-    Base::BoundBox3d BndBox;
 
     int i=0;
 
@@ -797,19 +863,19 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
             switch(num){
             case 3:
                 //tria3 face = N1, N2, N3
-                BndBox.Add(facesHelper[i++].set(3, aFace, aFace->GetID(), 0, aFace->GetNode(0), aFace->GetNode(1), aFace->GetNode(2)));
+                facesHelper[i++].set(3, aFace, aFace->GetID(), 0, aFace->GetNode(0), aFace->GetNode(1), aFace->GetNode(2));
                 break;
             case 4:
                 //quad4 face = N1, N2, N3, N4
-                BndBox.Add(facesHelper[i++].set(4, aFace, aFace->GetID(), 0, aFace->GetNode(0), aFace->GetNode(1), aFace->GetNode(2), aFace->GetNode(3)));
+                facesHelper[i++].set(4, aFace, aFace->GetID(), 0, aFace->GetNode(0), aFace->GetNode(1), aFace->GetNode(2), aFace->GetNode(3));
                 break;
             case 6:
                 //tria6 face = N1, N4, N2, N5, N3, N6
-                BndBox.Add(facesHelper[i++].set(6, aFace, aFace->GetID(), 0, aFace->GetNode(0), aFace->GetNode(3), aFace->GetNode(1), aFace->GetNode(4), aFace->GetNode(2), aFace->GetNode(5)));
+                facesHelper[i++].set(6, aFace, aFace->GetID(), 0, aFace->GetNode(0), aFace->GetNode(3), aFace->GetNode(1), aFace->GetNode(4), aFace->GetNode(2), aFace->GetNode(5));
                 break;
             case 8:
                 //quad8 face = N1, N5, N2, N6, N3, N7, N4, N8
-                BndBox.Add(facesHelper[i++].set(8, aFace, aFace->GetID(), 0, aFace->GetNode(0), aFace->GetNode(4), aFace->GetNode(1), aFace->GetNode(5), aFace->GetNode(2), aFace->GetNode(6), aFace->GetNode(3), aFace->GetNode(7)));
+                facesHelper[i++].set(8, aFace, aFace->GetID(), 0, aFace->GetNode(0), aFace->GetNode(4), aFace->GetNode(1), aFace->GetNode(5), aFace->GetNode(2), aFace->GetNode(6), aFace->GetNode(3), aFace->GetNode(7));
                 break;
             default:
                 //unknown face type
@@ -833,10 +899,10 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
                 // face 2 = N1, N4, N2
                 // face 3 = N2, N4, N3
                 // face 4 = N3, N4, N1
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(1), aVol->GetNode(2)));
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 2, aVol->GetNode(0), aVol->GetNode(3), aVol->GetNode(1)));
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 3, aVol->GetNode(1), aVol->GetNode(3), aVol->GetNode(2)));
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 4, aVol->GetNode(2), aVol->GetNode(3), aVol->GetNode(0)));
+                facesHelper[i++].set(3, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(1), aVol->GetNode(2));
+                facesHelper[i++].set(3, aVol, aVol->GetID(), 2, aVol->GetNode(0), aVol->GetNode(3), aVol->GetNode(1));
+                facesHelper[i++].set(3, aVol, aVol->GetID(), 3, aVol->GetNode(1), aVol->GetNode(3), aVol->GetNode(2));
+                facesHelper[i++].set(3, aVol, aVol->GetID(), 4, aVol->GetNode(2), aVol->GetNode(3), aVol->GetNode(0));
                 break;
             //pyra5 volume
             case 5:
@@ -845,11 +911,11 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
                 // face 3 = N2, N5, N3
                 // face 4 = N3, N5, N4
                 // face 5 = N4, N5, N1
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(1), aVol->GetNode(2), aVol->GetNode(3)));
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 2, aVol->GetNode(0), aVol->GetNode(4), aVol->GetNode(1)));
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 3, aVol->GetNode(1), aVol->GetNode(4), aVol->GetNode(2)));
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 4, aVol->GetNode(2), aVol->GetNode(4), aVol->GetNode(3)));
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 5, aVol->GetNode(3), aVol->GetNode(4), aVol->GetNode(0)));
+                facesHelper[i++].set(4, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(1), aVol->GetNode(2), aVol->GetNode(3));
+                facesHelper[i++].set(3, aVol, aVol->GetID(), 2, aVol->GetNode(0), aVol->GetNode(4), aVol->GetNode(1));
+                facesHelper[i++].set(3, aVol, aVol->GetID(), 3, aVol->GetNode(1), aVol->GetNode(4), aVol->GetNode(2));
+                facesHelper[i++].set(3, aVol, aVol->GetID(), 4, aVol->GetNode(2), aVol->GetNode(4), aVol->GetNode(3));
+                facesHelper[i++].set(3, aVol, aVol->GetID(), 5, aVol->GetNode(3), aVol->GetNode(4), aVol->GetNode(0));
                 break;
             //penta6 volume
             case 6:
@@ -858,11 +924,11 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
                 // face 3 = N1, N4, N5, N2
                 // face 4 = N2, N5, N6, N3
                 // face 5 = N3, N6, N4, N1
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(1), aVol->GetNode(2)));
-                BndBox.Add(facesHelper[i++].set(3, aVol, aVol->GetID(), 2, aVol->GetNode(3), aVol->GetNode(5), aVol->GetNode(4)));
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 3, aVol->GetNode(0), aVol->GetNode(3), aVol->GetNode(4), aVol->GetNode(1)));
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 4, aVol->GetNode(1), aVol->GetNode(4), aVol->GetNode(5), aVol->GetNode(2)));
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 5, aVol->GetNode(2), aVol->GetNode(5), aVol->GetNode(3), aVol->GetNode(0)));
+                facesHelper[i++].set(3, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(1), aVol->GetNode(2));
+                facesHelper[i++].set(3, aVol, aVol->GetID(), 2, aVol->GetNode(3), aVol->GetNode(5), aVol->GetNode(4));
+                facesHelper[i++].set(4, aVol, aVol->GetID(), 3, aVol->GetNode(0), aVol->GetNode(3), aVol->GetNode(4), aVol->GetNode(1));
+                facesHelper[i++].set(4, aVol, aVol->GetID(), 4, aVol->GetNode(1), aVol->GetNode(4), aVol->GetNode(5), aVol->GetNode(2));
+                facesHelper[i++].set(4, aVol, aVol->GetID(), 5, aVol->GetNode(2), aVol->GetNode(5), aVol->GetNode(3), aVol->GetNode(0));
                 break;
             //hexa8 volume
             case 8:
@@ -872,12 +938,12 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
                 // face 4 = N2, N6, N7, N3
                 // face 5 = N3, N7, N8, N4
                 // face 6 = N4, N8, N5, N1
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(1), aVol->GetNode(2), aVol->GetNode(3)));
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 2, aVol->GetNode(4), aVol->GetNode(7), aVol->GetNode(6), aVol->GetNode(5)));
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 3, aVol->GetNode(0), aVol->GetNode(4), aVol->GetNode(5), aVol->GetNode(1)));
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 4, aVol->GetNode(1), aVol->GetNode(5), aVol->GetNode(6), aVol->GetNode(2)));
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 5, aVol->GetNode(2), aVol->GetNode(6), aVol->GetNode(7), aVol->GetNode(3)));
-                BndBox.Add(facesHelper[i++].set(4, aVol, aVol->GetID(), 6, aVol->GetNode(3), aVol->GetNode(7), aVol->GetNode(4), aVol->GetNode(0)));
+                facesHelper[i++].set(4, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(1), aVol->GetNode(2), aVol->GetNode(3));
+                facesHelper[i++].set(4, aVol, aVol->GetID(), 2, aVol->GetNode(4), aVol->GetNode(7), aVol->GetNode(6), aVol->GetNode(5));
+                facesHelper[i++].set(4, aVol, aVol->GetID(), 3, aVol->GetNode(0), aVol->GetNode(4), aVol->GetNode(5), aVol->GetNode(1));
+                facesHelper[i++].set(4, aVol, aVol->GetID(), 4, aVol->GetNode(1), aVol->GetNode(5), aVol->GetNode(6), aVol->GetNode(2));
+                facesHelper[i++].set(4, aVol, aVol->GetID(), 5, aVol->GetNode(2), aVol->GetNode(6), aVol->GetNode(7), aVol->GetNode(3));
+                facesHelper[i++].set(4, aVol, aVol->GetID(), 6, aVol->GetNode(3), aVol->GetNode(7), aVol->GetNode(4), aVol->GetNode(0));
                 break;
             //tetra10 volume
             case 10:
@@ -885,10 +951,10 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
                 // face 2 = N1, N8,  N4, N9,  N2, N5
                 // face 3 = N2, N9,  N4, N10, N3, N6
                 // face 4 = N3, N10, N4, N8,  N1, N7
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(4), aVol->GetNode(1), aVol->GetNode(5), aVol->GetNode(2), aVol->GetNode(6)));
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 2, aVol->GetNode(0), aVol->GetNode(7), aVol->GetNode(3), aVol->GetNode(8), aVol->GetNode(1), aVol->GetNode(4)));
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 3, aVol->GetNode(1), aVol->GetNode(8), aVol->GetNode(3), aVol->GetNode(9), aVol->GetNode(2), aVol->GetNode(5)));
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 4, aVol->GetNode(2), aVol->GetNode(9), aVol->GetNode(3), aVol->GetNode(7), aVol->GetNode(0), aVol->GetNode(6)));
+                facesHelper[i++].set(6, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(4), aVol->GetNode(1), aVol->GetNode(5), aVol->GetNode(2), aVol->GetNode(6));
+                facesHelper[i++].set(6, aVol, aVol->GetID(), 2, aVol->GetNode(0), aVol->GetNode(7), aVol->GetNode(3), aVol->GetNode(8), aVol->GetNode(1), aVol->GetNode(4));
+                facesHelper[i++].set(6, aVol, aVol->GetID(), 3, aVol->GetNode(1), aVol->GetNode(8), aVol->GetNode(3), aVol->GetNode(9), aVol->GetNode(2), aVol->GetNode(5));
+                facesHelper[i++].set(6, aVol, aVol->GetID(), 4, aVol->GetNode(2), aVol->GetNode(9), aVol->GetNode(3), aVol->GetNode(7), aVol->GetNode(0), aVol->GetNode(6));
                 break;
             //pyra13 volume
             case 13:
@@ -897,11 +963,11 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
                 // face 3 = N2, N11, N5, N12, N3, N7
                 // face 4 = N3, N12, N5, N13, N4, N8
                 // face 5 = N4, N13, N5, N10, N1, N9
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(5),  aVol->GetNode(1), aVol->GetNode(6),  aVol->GetNode(2), aVol->GetNode(7), aVol->GetNode(3), aVol->GetNode(8)));
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 2, aVol->GetNode(0), aVol->GetNode(9),  aVol->GetNode(4), aVol->GetNode(10), aVol->GetNode(1), aVol->GetNode(5)));
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 3, aVol->GetNode(1), aVol->GetNode(10), aVol->GetNode(4), aVol->GetNode(11), aVol->GetNode(2), aVol->GetNode(6)));
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 4, aVol->GetNode(2), aVol->GetNode(11), aVol->GetNode(4), aVol->GetNode(12), aVol->GetNode(3), aVol->GetNode(7)));
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 5, aVol->GetNode(3), aVol->GetNode(12), aVol->GetNode(4), aVol->GetNode(9),  aVol->GetNode(0), aVol->GetNode(8)));
+                facesHelper[i++].set(8, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(5),  aVol->GetNode(1), aVol->GetNode(6),  aVol->GetNode(2), aVol->GetNode(7), aVol->GetNode(3), aVol->GetNode(8));
+                facesHelper[i++].set(6, aVol, aVol->GetID(), 2, aVol->GetNode(0), aVol->GetNode(9),  aVol->GetNode(4), aVol->GetNode(10), aVol->GetNode(1), aVol->GetNode(5));
+                facesHelper[i++].set(6, aVol, aVol->GetID(), 3, aVol->GetNode(1), aVol->GetNode(10), aVol->GetNode(4), aVol->GetNode(11), aVol->GetNode(2), aVol->GetNode(6));
+                facesHelper[i++].set(6, aVol, aVol->GetID(), 4, aVol->GetNode(2), aVol->GetNode(11), aVol->GetNode(4), aVol->GetNode(12), aVol->GetNode(3), aVol->GetNode(7));
+                facesHelper[i++].set(6, aVol, aVol->GetID(), 5, aVol->GetNode(3), aVol->GetNode(12), aVol->GetNode(4), aVol->GetNode(9),  aVol->GetNode(0), aVol->GetNode(8));
                 break;
             //penta15 volume
             case 15:
@@ -910,11 +976,11 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
                 // face 3 = N1, N13, N4, N10, N5, N14, N2, N7
                 // face 4 = N2, N14, N5, N11, N6, N15, N3, N8
                 // face 5 = N3, N15, N6, N12, N4, N13, N1, N9
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(6),  aVol->GetNode(1), aVol->GetNode(7),  aVol->GetNode(2), aVol->GetNode(8)));
-                BndBox.Add(facesHelper[i++].set(6, aVol, aVol->GetID(), 2, aVol->GetNode(3), aVol->GetNode(11), aVol->GetNode(5), aVol->GetNode(10), aVol->GetNode(4), aVol->GetNode(9)));
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 3, aVol->GetNode(0), aVol->GetNode(12), aVol->GetNode(3), aVol->GetNode(9),  aVol->GetNode(4), aVol->GetNode(13), aVol->GetNode(1), aVol->GetNode(6)));
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 4, aVol->GetNode(1), aVol->GetNode(13), aVol->GetNode(4), aVol->GetNode(10), aVol->GetNode(5), aVol->GetNode(14), aVol->GetNode(2), aVol->GetNode(7)));
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 5, aVol->GetNode(2), aVol->GetNode(14), aVol->GetNode(5), aVol->GetNode(11), aVol->GetNode(3), aVol->GetNode(12), aVol->GetNode(0), aVol->GetNode(8)));
+                facesHelper[i++].set(6, aVol, aVol->GetID(), 1, aVol->GetNode(0), aVol->GetNode(6),  aVol->GetNode(1), aVol->GetNode(7),  aVol->GetNode(2), aVol->GetNode(8));
+                facesHelper[i++].set(6, aVol, aVol->GetID(), 2, aVol->GetNode(3), aVol->GetNode(11), aVol->GetNode(5), aVol->GetNode(10), aVol->GetNode(4), aVol->GetNode(9));
+                facesHelper[i++].set(8, aVol, aVol->GetID(), 3, aVol->GetNode(0), aVol->GetNode(12), aVol->GetNode(3), aVol->GetNode(9),  aVol->GetNode(4), aVol->GetNode(13), aVol->GetNode(1), aVol->GetNode(6));
+                facesHelper[i++].set(8, aVol, aVol->GetID(), 4, aVol->GetNode(1), aVol->GetNode(13), aVol->GetNode(4), aVol->GetNode(10), aVol->GetNode(5), aVol->GetNode(14), aVol->GetNode(2), aVol->GetNode(7));
+                facesHelper[i++].set(8, aVol, aVol->GetID(), 5, aVol->GetNode(2), aVol->GetNode(14), aVol->GetNode(5), aVol->GetNode(11), aVol->GetNode(3), aVol->GetNode(12), aVol->GetNode(0), aVol->GetNode(8));
                 break;
             //hexa20 volume
             case 20:
@@ -924,12 +990,12 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
                 // face 4 = N2, N18, N6, N14, N7, N19, N3, N10
                 // face 5 = N3, N19, N7, N15, N8, N20, N4, N11
                 // face 6 = N4, N20, N8, N16, N5, N17, N1, N12
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 1, aVol->GetNode(0),  aVol->GetNode(8), aVol->GetNode(1),  aVol->GetNode(9), aVol->GetNode(2), aVol->GetNode(10), aVol->GetNode(3), aVol->GetNode(11)));
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 2, aVol->GetNode(4), aVol->GetNode(15), aVol->GetNode(7), aVol->GetNode(14), aVol->GetNode(6), aVol->GetNode(13), aVol->GetNode(5), aVol->GetNode(12)));
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 3, aVol->GetNode(0), aVol->GetNode(16), aVol->GetNode(4), aVol->GetNode(12), aVol->GetNode(5), aVol->GetNode(17), aVol->GetNode(1),  aVol->GetNode(8)));
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 4, aVol->GetNode(1), aVol->GetNode(17), aVol->GetNode(5), aVol->GetNode(13), aVol->GetNode(6), aVol->GetNode(18), aVol->GetNode(2),  aVol->GetNode(9)));
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 5, aVol->GetNode(2), aVol->GetNode(18), aVol->GetNode(6), aVol->GetNode(14), aVol->GetNode(7), aVol->GetNode(19), aVol->GetNode(3), aVol->GetNode(10)));
-                BndBox.Add(facesHelper[i++].set(8, aVol, aVol->GetID(), 6, aVol->GetNode(3), aVol->GetNode(19), aVol->GetNode(7), aVol->GetNode(15), aVol->GetNode(4), aVol->GetNode(16), aVol->GetNode(0), aVol->GetNode(11)));
+                facesHelper[i++].set(8, aVol, aVol->GetID(), 1, aVol->GetNode(0),  aVol->GetNode(8), aVol->GetNode(1),  aVol->GetNode(9), aVol->GetNode(2), aVol->GetNode(10), aVol->GetNode(3), aVol->GetNode(11));
+                facesHelper[i++].set(8, aVol, aVol->GetID(), 2, aVol->GetNode(4), aVol->GetNode(15), aVol->GetNode(7), aVol->GetNode(14), aVol->GetNode(6), aVol->GetNode(13), aVol->GetNode(5), aVol->GetNode(12));
+                facesHelper[i++].set(8, aVol, aVol->GetID(), 3, aVol->GetNode(0), aVol->GetNode(16), aVol->GetNode(4), aVol->GetNode(12), aVol->GetNode(5), aVol->GetNode(17), aVol->GetNode(1),  aVol->GetNode(8));
+                facesHelper[i++].set(8, aVol, aVol->GetID(), 4, aVol->GetNode(1), aVol->GetNode(17), aVol->GetNode(5), aVol->GetNode(13), aVol->GetNode(6), aVol->GetNode(18), aVol->GetNode(2),  aVol->GetNode(9));
+                facesHelper[i++].set(8, aVol, aVol->GetID(), 5, aVol->GetNode(2), aVol->GetNode(18), aVol->GetNode(6), aVol->GetNode(14), aVol->GetNode(7), aVol->GetNode(19), aVol->GetNode(3), aVol->GetNode(10));
+                facesHelper[i++].set(8, aVol, aVol->GetID(), 6, aVol->GetNode(3), aVol->GetNode(19), aVol->GetNode(7), aVol->GetNode(15), aVol->GetNode(4), aVol->GetNode(16), aVol->GetNode(0), aVol->GetNode(11));
                 break;
             //unknown volume type
             default:
@@ -940,90 +1006,39 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
     int FaceSize = facesHelper.size();
 
 
-    if( FaceSize < MaxFacesShowInner){
-        Base::Console().Log("    %f: Start eliminate internal faces SIMPLE\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
-
-        // search for double (inside) faces and hide them
-        if(!ShowInner){
-            for(int l=0; l< FaceSize;l++){
-                if(! facesHelper[l].hide){
-                    for(int i=l+1; i<FaceSize; i++){
-                        if(facesHelper[l].isSameFace(facesHelper[i]) ){
-                            break;
-                        }
-                    }
-                }
+    // Search for double (inside) faces and hide them. Inner faces are always
+    // eliminated for large meshes regardless of ShowInner.
+    if(!ShowInner || FaceSize >= MaxFacesShowInner){
+        Base::Console().Log("    %f: Start eliminate internal faces\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
+
+        // Partition the faces by the hash of their sorted nodes, so that
+        // identical faces always end up in the same partition, and then
+        // process the partitions concurrently.
+        int numParts = std::max(1, QThread::idealThreadCount()) * 4;
+        std::vector<FemFaceGridItem> Parts(numParts);
+        for(auto &part : Parts)
+            part.reserve(FaceSize/numParts+1);
+        FemFaceHasher hasher;
+        for(int l=0; l< FaceSize;l++)
+            Parts[hasher(&facesHelper[l]) % numParts].push_back(&facesHelper[l]);
+
+        QtConcurrent::blockingMap(Parts, [](FemFaceGridItem &part) {
+            std::unordered_map<FemFace*, FemFace*, FemFaceHasher, FemFaceHasher> faceMap;
+            faceMap.reserve(part.size());
+            for(auto face : part) {
+                auto res = faceMap.emplace(face, face);
+                if(!res.second)
+                    res.first->second->isSameFace(*face);
             }
-        }
-    }else{
-        Base::Console().Log("    %f: Start eliminate internal faces GRID\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
-        BndBox.Enlarge(BndBox.CalcDiagonalLength()/10000.0);
-        // calculate grid properties
-        double edge = pow(FaceSize,1.0/3.0);
-        double edgeL = BndBox.LengthX() + BndBox.LengthY() + BndBox.LengthZ();
-        double gridFactor = 5.0;
-        double size = ( edgeL /(3*edge) )*gridFactor;
-
-        unsigned int NbrX = (unsigned int)(BndBox.LengthX()/size)+1;
-        unsigned int NbrY = (unsigned int)(BndBox.LengthY()/size)+1;
-        unsigned int NbrZ = (unsigned int)(BndBox.LengthZ()/size)+1;
-        Base::Console().Log("      Size:F:%f,  X:%i  ,Y:%i  ,Z:%i\n",gridFactor,NbrX,NbrY,NbrZ);
-
-        double Xmin = BndBox.MinX;
-        double Ymin = BndBox.MinY;
-        double Zmin = BndBox.MinZ;
-        double Xln  = BndBox.LengthX() / NbrX;
-        double Yln  = BndBox.LengthY() / NbrY;
-        double Zln  = BndBox.LengthZ() / NbrZ;
-
-        std::vector<FemFaceGridItem> Grid(NbrX*NbrY*NbrZ);
-
-
-        unsigned int iX = 0;
-        unsigned int iY = 0;
-        unsigned int iZ = 0;
-
-        for(int l=0; l< FaceSize;l++){
-            Base::Vector3d point(facesHelper[l].getFirstNodePoint());
-            double x = (point.x - Xmin) / Xln;
-            double y = (point.y - Ymin) / Yln;
-            double z = (point.z - Zmin) / Zln;
-
-            iX = x;
-            iY = y;
-            iZ = z;
-
-            if(iX >= NbrX || iY >= NbrY || iZ >= NbrZ)
-                Base::Console().Log("      Outof range!\n");
-
-            Grid[iX + iY*NbrX + iZ*NbrX*NbrY].push_back(&facesHelper[l]);
-        }
-
-        unsigned int max =0, avg = 0;
-        for(std::vector<FemFaceGridItem>::iterator it=Grid.begin();it!=Grid.end();++it){
-            for(unsigned int l=0; l< it->size();l++){
-                if(! it->operator[](l)->hide){
-                    for(unsigned int i=l+1; i<it->size(); i++){
-                        if(it->operator[](l)->isSameFace(*(it->operator[](i))) ){
-                            break;
-                        }
-                    }
-                }
-            }
-            if(it->size() > max)max=it->size();
-            avg += it->size();
-        }
-        avg = avg/Grid.size();
-
-        Base::Console().Log("      VoxelSize: Max:%i ,Average:%i\n",max,avg);
-
-    } //if( FaceSize < 1000)
+        });
+    }
 
 
     Base::Console().Log("    %f: Start build up node map\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
 
     // sort out double nodes and build up index map
-    std::map<const SMDS_MeshNode*, int> mapNodeIndex;
+    std::unordered_map<const SMDS_MeshNode*, int> mapNodeIndex;
+    mapNodeIndex.reserve(numNodes);
 
     // handling the corner case beams only, means no faces/triangles only nodes and edges
     if (onlyEdges){
@@ -1055,7 +1070,7 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
     // set the point coordinates
     coords->point.setNum(mapNodeIndex.size());
     vNodeElementIdx.resize(mapNodeIndex.size() );
-    std::map<const SMDS_MeshNode*, int>::iterator it=  mapNodeIndex.begin();
+    auto it = mapNodeIndex.begin();
     SbVec3f* verts = coords->point.startEditing();
     for (int i=0;it != mapNodeIndex.end() ;++it,i++) {
         verts[i].setValue((float)it->first->X(),(float)it->first->Y(),(float)it->first->Z());
@@ -112,18 +112,32 @@ public:
     /// set the color for each node
     void setColorByNodeId(const std::map<long,App::Color> &NodeColorMap);
     void setColorByNodeId(const std::vector<long> &NodeIds,const std::vector<App::Color>  &NodeColors);
+    /** set the color for each node from a dense array
+     * @param NodeColors: color array indexed by node ID minus \c startId
+     * @param count: number of items in the array
+     * @param startId: the node ID of the first item
+     */
+    void setColorByNodeId(const App::Color *NodeColors, long count, long startId);
 
     /// reset the view of the node colors
     void resetColorByNodeId(void);
     /// set the displacement for each node
     void setDisplacementByNodeId(const std::map<long,Base::Vector3d> &NodeDispMap);
     void setDisplacementByNodeId(const std::vector<long> &NodeIds,const std::vector<Base::Vector3d> &NodeDisps);
+    /** set the displacement for each node from a dense array
+     * @param NodeDisps: array of x, y, z triples indexed by node ID minus \c startId
+     * @param count: number of nodes in the array, i.e. a third of the array size
+     * @param startId: the node ID of the first triple
+     */
+    void setDisplacementByNodeId(const double *NodeDisps, long count, long startId);
     /// reset the view of the node displacement
     void resetDisplacementByNodeId(void);
     /// reaply the node displacement with a certain factor and do a redraw
     void applyDisplacementToNodes(double factor);
     /// set the color for each element
     void setColorByElementId(const std::map<long,App::Color> &ElementColorMap);
+    /// set the color for each element from a dense array indexed by element ID minus \c startId
+    void setColorByElementId(const App::Color *ElementColors, long count, long startId);
     /// reset the view of the element colors
     void resetColorByElementId(void);
     //@}
@@ -141,7 +155,6 @@ protected:
     /// get called by the container whenever a property has been changed
     virtual void onChanged(const App::Property* prop);
 
-    void setColorByNodeIdHelper(const std::vector<App::Color> &);
     void setDisplacementByNodeIdHelper(const std::vector<Base::Vector3d>& DispVector,long startId);
     /// index of elements to their triangles
     std::vector<unsigned long> vFaceElementIdx;
@@ -144,6 +144,103 @@ PyObject* ViewProviderFemMeshPy::setNodeDisplacementByVectors(PyObject *args)
 }
 
 
+namespace {
+
+// Dense array of doubles, taken without copying from any object supporting
+// the buffer protocol with double items (e.g. numpy.ndarray), or else copied
+// out of a flat sequence of floats.
+class DoubleArray
+{
+public:
+    explicit DoubleArray(PyObject *obj)
+        : hasView(false), data(0), count(0)
+    {
+        if (PyObject_CheckBuffer(obj)
+                && PyObject_GetBuffer(obj, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == 0)
+        {
+            hasView = true;
+            const char *format = view.format ? view.format : "B";
+            if (*format == '@' || *format == '=')
+                ++format;
+            if (strcmp(format, "d") != 0 || view.itemsize != sizeof(double)) {
+                PyBuffer_Release(&view);
+                throw Py::TypeError("Expect a contiguous array of double");
+            }
+            data = static_cast<const double*>(view.buf);
+            count = view.len / sizeof(double);
+            return;
+        }
+        PyErr_Clear();
+        Py::Sequence seq(obj);
+        storage.reserve(seq.size());
+        for (Py::Sequence::iterator it = seq.begin(); it != seq.end(); ++it)
+            storage.push_back(static_cast<double>(Py::Float(*it)));
+        data = storage.data();
+        count = static_cast<long>(storage.size());
+    }
+
+    ~DoubleArray()
+    {
+        if (hasView)
+            PyBuffer_Release(&view);
+    }
+
+    const double *begin() const {return data;}
+    const double *end() const {return data + count;}
+    long size() const {return count;}
+
+private:
+    Py_buffer view;
+    bool hasView;
+    std::vector<double> storage;
+    const double *data;
+    long count;
+};
+
+}
+
+PyObject* ViewProviderFemMeshPy::setNodeColorByScalarArray(PyObject *args)
+{
+    PyObject *values_py;
+    long startId = 1;
+    if (!PyArg_ParseTuple(args, "O|l", &values_py, &startId))
+        return 0;
+
+    DoubleArray values(values_py);
+    double max = -1e12;
+    double min = +1e12;
+    for (double val : values) {
+        if(val > max)
+            max = val;
+        if(val < min)
+            min = val;
+    }
+    std::vector<App::Color> node_colors(values.size());
+    long i=0;
+    for (double val : values)
+        node_colors[i++] = calcColor(val, min, max);
+    this->getViewProviderFemMeshPtr()->setColorByNodeId(node_colors.data(), values.size(), startId);
+    Py_Return;
+}
+
+
+PyObject* ViewProviderFemMeshPy::setNodeDisplacementByArray(PyObject *args)
+{
+    PyObject *vectors_py;
+    long startId = 1;
+    if (!PyArg_ParseTuple(args, "O|l", &vectors_py, &startId))
+        return 0;
+
+    DoubleArray vectors(vectors_py);
+    if (vectors.size() % 3) {
+        PyErr_SetString(PyExc_ValueError, "Expect the array size to be a multiple of three");
+        return 0;
+    }
+    this->getViewProviderFemMeshPtr()->setDisplacementByNodeId(vectors.begin(), vectors.size()/3, startId);
+    Py_Return;
+}
+
+
 PyObject* ViewProviderFemMeshPy::resetNodeDisplacement(PyObject *args)
 {
     if (!PyArg_ParseTuple(args, ""))
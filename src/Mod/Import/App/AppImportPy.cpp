@@ -292,9 +292,10 @@ private:
         PyObject *exportHidden = Py_None;
         PyObject *legacy = Py_None;
         PyObject *keepPlacement = Py_None;
-        static char* kwd_list[] = {"obj", "name", "exportHidden", "legacy", "keepPlacement",0};
-        if(!PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "Oet|OOO",
-                    kwd_list,&object,"utf-8",&Name,&exportHidden,&legacy,&keepPlacement))
+        PyObject *instancing = Py_None;
+        static char* kwd_list[] = {"obj", "name", "exportHidden", "legacy", "keepPlacement", "instancing",0};
+        if(!PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "Oet|OOOO",
+                    kwd_list,&object,"utf-8",&Name,&exportHidden,&legacy,&keepPlacement,&instancing))
             throw Py::Exception();
 
         std::string Utf8Name = std::string(Name);
@@ -326,6 +327,8 @@ private:
                     ocaf.setExportHiddenObject(PyObject_IsTrue(exportHidden));
                 if(keepPlacement!=Py_None)
                     ocaf.setKeepPlacement(PyObject_IsTrue(keepPlacement));
+                if(instancing!=Py_None)
+                    ocaf.setUseInstancing(PyObject_IsTrue(instancing));
                 ocaf.exportObjects(objs);
             }
             else {
@@ -202,29 +202,19 @@ void ImpExpDxfRead::OnReadInsert(const double* point, const double* scale, const
     std::string prefix = "BLOCKS ";
     prefix += name;
     prefix += " ";
-    for(std::map<std::string,std::vector<Part::TopoShape*> > ::const_iterator i = layers.begin(); i != layers.end(); ++i) {
-        std::string k = i->first;
-        if(k.substr(0, prefix.size()) == prefix) {
-            BRep_Builder builder;
-            TopoDS_Compound comp;
-            builder.MakeCompound(comp);
-            std::vector<Part::TopoShape*> v = i->second;
-            for(std::vector<Part::TopoShape*>::const_iterator j = v.begin(); j != v.end(); ++j) { 
-                const TopoDS_Shape& sh = (*j)->getShape();
-                if (!sh.IsNull())
-                    builder.Add(comp, sh);
-            }
-            if (!comp.IsNull()) {
-                Part::TopoShape* pcomp = new Part::TopoShape(comp);
-                Base::Matrix4D mat;
-                mat.scale(scale[0],scale[1],scale[2]);
-                mat.rotZ(rotation);
-                mat.move(point[0]*optionScaling,point[1]*optionScaling,point[2]*optionScaling);
-                pcomp->transformShape(mat,true);
-                AddObject(pcomp);
-            }
-        }
-    } 
+    // block layers are named "BLOCKS <name> <layer>", so they are adjacent in the map
+    std::map<std::string,TopoDS_Compound>::const_iterator i = layers.lower_bound(prefix);
+    for(; i != layers.end() && i->first.compare(0, prefix.size(), prefix) == 0; ++i) {
+        // the block compound was built while reading the block, copy it so that
+        // it stays free for further entities of the block
+        Part::TopoShape* pcomp = new Part::TopoShape(i->second);
+        Base::Matrix4D mat;
+        mat.scale(scale[0],scale[1],scale[2]);
+        mat.rotZ(rotation);
+        mat.move(point[0]*optionScaling,point[1]*optionScaling,point[2]*optionScaling);
+        pcomp->transformShape(mat,true);
+        AddObject(pcomp);
+    }
 }
 
 
@@ -243,17 +233,21 @@ void ImpExpDxfRead::OnReadDimension(const double* s, const double* e, const doub
 void ImpExpDxfRead::AddObject(Part::TopoShape *shape)
 {
     //std::cout << "layer:" << LayerName() << std::endl;
-    std::vector <Part::TopoShape*> vec;
-    if (layers.count(LayerName()))
-        vec = layers[LayerName()];
-    vec.push_back(shape);
-    layers[LayerName()] = vec;
-    if (!optionGroupLayers) {
-        if(LayerName().substr(0, 6) != "BLOCKS") {
-            Part::Feature *pcFeature = (Part::Feature *)document->addObject("Part::Feature", "Shape");
-            pcFeature->Shape.setValue(shape->getShape());
-        }
+    std::string layerName = LayerName();
+    const TopoDS_Shape& sh = shape->getShape();
+    bool block = layerName.compare(0, 6, "BLOCKS") == 0;
+    if (!optionGroupLayers && !block) {
+        Part::Feature *pcFeature = (Part::Feature *)document->addObject("Part::Feature", "Shape");
+        pcFeature->Shape.setValue(sh);
+    }
+    else if (!sh.IsNull()) {
+        BRep_Builder builder;
+        TopoDS_Compound &comp = layers[layerName];
+        if (comp.IsNull())
+            builder.MakeCompound(comp);
+        builder.Add(comp, sh);
     }
+    delete shape;
 }
 
 
@@ -299,24 +293,13 @@ std::string ImpExpDxfRead::Deformat(const char* text)
 void ImpExpDxfRead::AddGraphics() const
 {
     if (optionGroupLayers) {
-        for(std::map<std::string,std::vector<Part::TopoShape*> > ::const_iterator i = layers.begin(); i != layers.end(); ++i) {
-            BRep_Builder builder;
-            TopoDS_Compound comp;
-            builder.MakeCompound(comp);
+        for(std::map<std::string,TopoDS_Compound>::const_iterator i = layers.begin(); i != layers.end(); ++i) {
             std::string k = i->first;
             if (k == "0") // FreeCAD doesn't like an object name being '0'...
                 k = "LAYER_0";
-            std::vector<Part::TopoShape*> v = i->second;
             if(k.substr(0, 6) != "BLOCKS") {
-                for(std::vector<Part::TopoShape*>::const_iterator j = v.begin(); j != v.end(); ++j) { 
-                    const TopoDS_Shape& sh = (*j)->getShape();
-                    if (!sh.IsNull())
-                        builder.Add(comp, sh);
-                }
-                if (!comp.IsNull()) {
-                    Part::Feature *pcFeature = (Part::Feature *)document->addObject("Part::Feature", k.c_str());
-                    pcFeature->Shape.setValue(comp);
-                } 
+                Part::Feature *pcFeature = (Part::Feature *)document->addObject("Part::Feature", k.c_str());
+                pcFeature->Shape.setValue(i->second);
             }
         }
     }
@@ -27,6 +27,7 @@
 #include <Mod/Part/App/TopoShape.h>
 #include <App/Document.h>
 #include <gp_Pnt.hxx>
+#include <TopoDS_Compound.hxx>
 
 class BRepAdaptor_Curve;
 
@@ -50,7 +51,7 @@ namespace Import
         void AddGraphics() const;
     
         // FreeCAD-specific functions
-        void AddObject(Part::TopoShape *shape); //Called by OnRead functions to add Part objects
+        void AddObject(Part::TopoShape *shape); //Called by OnRead functions to add Part objects, takes ownership of shape
         std::string Deformat(const char* text); // Removes DXF formatting from texts
 
         std::string getOptionSource() { return m_optionSource; }
@@ -65,7 +66,7 @@ namespace Import
         bool optionGroupLayers;
         bool optionImportAnnotations;
         double optionScaling;
-        std::map <std::string, std::vector <Part::TopoShape*> > layers;
+        std::map <std::string, TopoDS_Compound> layers; // entities are added to their layer compound as they are read
         std::string m_optionSource;
     };
 
@@ -53,6 +53,7 @@
 #include <Base/Parameter.h>
 #include <Base/Console.h>
 #include <Base/FileInfo.h>
+#include <Base/Matrix.h>
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/DocumentObjectPy.h>
@@ -954,6 +955,7 @@ ExportOCAF2::ExportOCAF2(Handle(TDocStd_Document) h, GetShapeColorsFunc func)
     auto hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Import");
     exportHidden = hGrp->GetBool("ExportHiddenObject",true);
     keepPlacement = hGrp->GetBool("ExportKeepPlacement",false);
+    useInstancing = hGrp->GetBool("ExportInstancing",false);
 
     Interface_Static::SetIVal("write.step.assembly",2);
 
@@ -1181,7 +1183,9 @@ void ExportOCAF2::setupObject(TDF_Label label, App::DocumentObject *obj,
 void ExportOCAF2::exportObjects(std::vector<App::DocumentObject*> &objs, const char *name) {
     if(objs.empty())
         return;
+    FC_TIME_INIT(t);
     myObjects.clear();
+    myShapes.clear();
     myNames.clear();
     mySetups.clear();
     if(objs.size()==1)
@@ -1210,6 +1214,30 @@ void ExportOCAF2::exportObjects(std::vector<App::DocumentObject*> &objs, const c
     // Update is not performed automatically anymore: https://tracker.dev.opencascade.org/view.php?id=28055
     aShapeTool->UpdateAssemblies();
 #endif
+
+    FC_TIME_LOG(t,"export " << myObjects.size() << " objects, "
+            << myShapes.size() << " unique shapes");
+}
+
+// Check whether the shape of a link may differ from the linked object by more
+// than its placement, e.g. because of hidden or colored elements, link array
+// elements, or an owned copy of the linked object.
+static bool hasElementOverride(App::DocumentObject *obj)
+{
+    auto ext = obj->getExtensionByType<App::LinkBaseExtension>(true);
+    if(!ext)
+        return true;
+    if(ext->getLinkCopyOnChangeValue()
+            || ext->_getElementCountValue()
+            || !ext->_getElementListValue().empty())
+        return true;
+    auto colored = ext->getColoredElementsProperty();
+    if(colored && !colored->getSubValues().empty())
+        return true;
+    auto vis = ext->getVisibilityListProperty();
+    if(vis && vis->getValues().count()!=vis->getValues().size())
+        return true;
+    return false;
 }
 
 TDF_Label ExportOCAF2::exportObject(App::DocumentObject* parentObj, 
@@ -1245,14 +1273,28 @@ TDF_Label ExportOCAF2::exportObject(App::DocumentObject* parentObj,
     TDF_Label label;
     std::vector<App::DocumentObject *> links;
 
+    // In instancing mode, an object reached through a link without scaling is
+    // exported as a located instance of the previously exported object, even
+    // if its shape is regenerated (hence not a partner) by the link. This is
+    // only done if none of the links on the way overrides any element of the
+    // linked object, see hasElementOverride().
+    Base::Matrix4D mat;
+    bool rigid = useInstancing
+        && parentObj->getSubObject(sub,0,&mat,!sub)
+        && !mat.hasScale();
+
     int depth = 0;
     auto linked = obj;
     auto linkedShape = shape;
     while(1) {
         auto s = Part::Feature::getTopoShape(linked);
-        if(s.isNull() || !s.getShape().IsPartner(shape.getShape()))
+        if(s.isNull())
+            break;
+        bool partner = s.getShape().IsPartner(shape.getShape());
+        if(partner)
+            linkedShape = s;
+        else if(links.empty() || !rigid || !myObjects.count(linked))
             break;
-        linkedShape = s;
         // Search using our own cache. We can't rely on ShapeTool::FindShape()
         // in case this is an assembly. Because FindShape() search among its
         // own computed shape, i.e. its own created compound, and thus will
@@ -1269,7 +1311,16 @@ TDF_Label ExportOCAF2::exportObject(App::DocumentObject* parentObj,
             // retrieve OCAF computed shape, in case the current object returns
             // a new shape every time Part::Feature::getTopoShape() is called.
             auto baseShape = aShapeTool->GetShape(it->second);
-            shape.setShape(baseShape.Located(shape.getShape().Location()),false);
+            myShapes.emplace(baseShape,it->second);
+            // The location of a regenerated shape may not reflect its
+            // placement, as the geometry itself may have been transformed.
+            // Use the accumulated link transformation instead.
+            TopLoc_Location loc;
+            if(partner)
+                loc = shape.getShape().Location();
+            else
+                loc = TopLoc_Location(Part::TopoShape::convert(mat));
+            shape.setShape(baseShape.Located(loc),false);
             if(!parent.IsNull())
                 label = aShapeTool->AddComponent(parent,shape.getShape(),Standard_False);
             else
@@ -1277,9 +1328,10 @@ TDF_Label ExportOCAF2::exportObject(App::DocumentObject* parentObj,
             setupObject(label,name?parentObj:obj,shape,prefix,name);
             return label;
         }
-        auto next = linked->getLinkedObject(false,0,false,depth++);
+        auto next = linked->getLinkedObject(false,&mat,false,depth++);
         if(!next || linked==next)
             break;
+        rigid = rigid && !mat.hasScale() && !hasElementOverride(linked);
         linked = next;
         links.push_back(linked);
     }
@@ -1289,13 +1341,20 @@ TDF_Label ExportOCAF2::exportObject(App::DocumentObject* parentObj,
     if(subs.empty()) {
 
         if(!parent.IsNull()) {
-            // Search for non-located shape to see if we've stored the original shape before
-            if(!aShapeTool->FindShape(shape.getShape(),label)) {
+            // Search for non-located shape to see if we've stored the original
+            // shape before. Use our own map instead of ShapeTool::FindShape(),
+            // which does a linear search of all top level labels.
+            auto res = myShapes.emplace(
+                    shape.getShape().Located(TopLoc_Location()), TDF_Label());
+            if(!res.second)
+                label = res.first->second;
+            else {
                 auto baseShape = linkedShape;
                 auto linked = links.empty()?obj:links.back();
                 baseShape.setShape(baseShape.getShape().Located(TopLoc_Location()),false);
                 label = aShapeTool->NewShape();
                 aShapeTool->SetShape(label,baseShape.getShape());
+                res.first->second = label;
                 setupObject(label,linked,baseShape,prefix);
             }
 
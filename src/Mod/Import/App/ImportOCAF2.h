@@ -61,6 +61,14 @@ struct ShapeHasher {
     }
 };
 
+// Matches shapes the way XCAFDoc_ShapeTool::FindShape() does, i.e. ignoring
+// orientation
+struct ShapeIsSame {
+    bool operator()(const TopoDS_Shape &a, const TopoDS_Shape &b) const {
+        return a.IsSame(b);
+    }
+};
+
 struct LabelHasher {
     std::size_t operator()(const TDF_Label &l) const {
         return TDF_LabelMapHasher::HashCode(l,INT_MAX);
@@ -181,6 +189,15 @@ public:
 
     void setExportHiddenObject(bool enable) {exportHidden=enable;}
     void setKeepPlacement(bool enable) {keepPlacement=enable;}
+    /** Enable instanced export
+     *
+     * If enabled, objects that are reached more than once, e.g. through links
+     * to a container, are exported only once and referred to by located
+     * component instances, as long as the link does not carry any scaling,
+     * and does not override the linked object's elements, e.g. by hiding or
+     * coloring them.
+     */
+    void setUseInstancing(bool enable) {useInstancing=enable;}
     void exportObjects(std::vector<App::DocumentObject*> &objs, const char *name=0);
     bool canFallback(std::vector<App::DocumentObject*> objs);
 
@@ -199,6 +216,10 @@ private:
 
     std::unordered_map<App::DocumentObject *, TDF_Label> myObjects;
 
+    // non-located shape to its prototype label, to avoid the linear search of
+    // XCAFDoc_ShapeTool::FindShape()
+    std::unordered_map<TopoDS_Shape, TDF_Label, ShapeHasher, ShapeIsSame> myShapes;
+
     std::unordered_map<TDF_Label, std::vector<std::string>, LabelHasher> myNames;
 
     std::set<std::pair<App::DocumentObject*,std::string> > mySetups;
@@ -210,6 +231,7 @@ private:
     App::Color defaultColor;
     bool exportHidden;
     bool keepPlacement;
+    bool useInstancing;
 };
 
 }
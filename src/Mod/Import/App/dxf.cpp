@@ -1752,20 +1752,30 @@ CDxfRead::CDxfRead(const char* filepath)
     memset( m_section_name, '\0', sizeof(m_section_name) );
     memset( m_block_name, '\0', sizeof(m_block_name) );
     m_ignore_errors = true;
-
-    m_ifs = new ifstream(filepath);
-    if(!(*m_ifs)){
+    m_pos = 0;
+    m_eof = true;
+
+    ifstream ifs(filepath, ios::in | ios::binary);
+    if(ifs) {
+        ifs.seekg(0, ios::end);
+        streamoff size = ifs.tellg();
+        ifs.seekg(0, ios::beg);
+        if(size > 0) {
+            m_buffer.resize(static_cast<size_t>(size));
+            ifs.read(&m_buffer[0], size);
+        }
+    }
+    if(!ifs){
         m_fail = true;
         printf("DXF file didn't load\n");
         return;
     }
-    m_ifs->imbue(std::locale("C"));
-
+    m_pos = m_buffer.data();
+    m_eof = m_buffer.empty();
 }
 
 CDxfRead::~CDxfRead()
 {
-    delete m_ifs;
 }
 
 double CDxfRead::mm( double value ) const
@@ -1809,7 +1819,7 @@ bool CDxfRead::ReadLine()
     double e[3] = {0, 0, 0};
     bool hidden = false;
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -1821,7 +1831,7 @@ bool CDxfRead::ReadLine()
         }
 
         std::istringstream ss;
-        ss.imbue(std::locale("C"));
+        ss.imbue(std::locale::classic());
         switch(n){
             case 0:
                 // next item found, so finish with line
@@ -1907,7 +1917,7 @@ bool CDxfRead::ReadPoint()
 {
     double s[3] = {0, 0, 0};
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -1919,7 +1929,7 @@ bool CDxfRead::ReadPoint()
         }
 
         std::istringstream ss;
-        ss.imbue(std::locale("C"));
+        ss.imbue(std::locale::classic());
         switch(n){
             case 0:
                 // next item found, so finish with line
@@ -1991,7 +2001,7 @@ bool CDxfRead::ReadArc()
     double z_extrusion_dir = 1.0;
     bool hidden = false;
     
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -2002,7 +2012,7 @@ bool CDxfRead::ReadArc()
         }
 
         std::istringstream ss;
-        ss.imbue(std::locale("C"));
+        ss.imbue(std::locale::classic());
         switch(n){
             case 0:
                 // next item found, so finish with arc
@@ -2097,7 +2107,7 @@ bool CDxfRead::ReadSpline()
 
     double temp_double;
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -2107,7 +2117,7 @@ bool CDxfRead::ReadSpline()
             return false;
         }
         std::istringstream ss;
-        ss.imbue(std::locale("C"));
+        ss.imbue(std::locale::classic());
         switch(n){
             case 0:
                 // next item found, so finish with Spline
@@ -2271,7 +2281,7 @@ bool CDxfRead::ReadCircle()
     double c[3] = {0,0,0}; // centre
     bool hidden = false;
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -2281,7 +2291,7 @@ bool CDxfRead::ReadCircle()
             return false;
         }
         std::istringstream ss;
-        ss.imbue(std::locale("C"));
+        ss.imbue(std::locale::classic());
         switch(n){
             case 0:
                 // next item found, so finish with Circle
@@ -2353,7 +2363,7 @@ bool CDxfRead::ReadText()
 
     memset( c, 0, sizeof(c) );
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -2363,7 +2373,7 @@ bool CDxfRead::ReadText()
             return false;
         }
         std::istringstream ss;
-        ss.imbue(std::locale("C"));
+        ss.imbue(std::locale::classic());
         switch(n){
             case 0:
                 return false;
@@ -2432,7 +2442,7 @@ bool CDxfRead::ReadEllipse()
     double start=0; //start of arc
     double end=0;  // end of arc
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -2442,7 +2452,7 @@ bool CDxfRead::ReadEllipse()
             return false;
         }
         std::istringstream ss;
-        ss.imbue(std::locale("C"));
+        ss.imbue(std::locale::classic());
         switch(n){
             case 0:
                 // next item found, so finish with Ellipse
@@ -2602,7 +2612,7 @@ bool CDxfRead::ReadLwPolyLine()
     int flags;
     bool next_item_found = false;
 
-    while(!((*m_ifs).eof()) && !next_item_found)
+    while(!m_eof && !next_item_found)
     {
         get_line();
         int n;
@@ -2612,7 +2622,7 @@ bool CDxfRead::ReadLwPolyLine()
             return false;
         }
         std::istringstream ss;
-        ss.imbue(std::locale("C"));
+        ss.imbue(std::locale::classic());
         switch(n){
             case 0:
                 // next item found
@@ -2709,7 +2719,7 @@ bool CDxfRead::ReadVertex(double *pVertex, bool *bulge_found, double *bulge)
     pVertex[1] = 0.0;
     pVertex[2] = 0.0;
 
-    while(!(*m_ifs).eof()) {
+    while(!m_eof) {
         get_line();
         int n;
         if(sscanf(m_str, "%d", &n) != 1) {
@@ -2717,7 +2727,7 @@ bool CDxfRead::ReadVertex(double *pVertex, bool *bulge_found, double *bulge)
             return false;
         }
         std::istringstream ss;
-        ss.imbue(std::locale("C"));
+        ss.imbue(std::locale::classic());
         switch(n){
         case 0:
         DerefACI();
@@ -2782,7 +2792,7 @@ bool CDxfRead::ReadPolyLine()
     bool bulge_found;
     double bulge;
 
-    while(!(*m_ifs).eof())
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -2792,7 +2802,7 @@ bool CDxfRead::ReadPolyLine()
             return false;
         }
         std::istringstream ss;
-        ss.imbue(std::locale("C"));
+        ss.imbue(std::locale::classic());
         switch(n){
             case 0:
                 // next item found
@@ -2904,7 +2914,7 @@ bool CDxfRead::ReadInsert()
     double rot = 0.0; // rotation
     char name[1024] = {0};
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -2914,7 +2924,7 @@ bool CDxfRead::ReadInsert()
             return false;
         }
         std::istringstream ss;
-        ss.imbue(std::locale("C"));
+        ss.imbue(std::locale::classic());
         switch(n){
             case 0: 
                 // next item found
@@ -2996,7 +3006,7 @@ bool CDxfRead::ReadDimension()
     double p[3] = {0,0,0}; // dimpoint
     double rot = -1.0; // rotation
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -3006,7 +3016,7 @@ bool CDxfRead::ReadDimension()
             return false;
         }
         std::istringstream ss;
-        ss.imbue(std::locale("C"));
+        ss.imbue(std::locale::classic());
         switch(n){
             case 0: 
                 // next item found
@@ -3093,7 +3103,7 @@ bool CDxfRead::ReadDimension()
 
 bool CDxfRead::ReadBlockInfo()
 {
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -3103,7 +3113,7 @@ bool CDxfRead::ReadBlockInfo()
             return false;
         }
         std::istringstream ss;
-        ss.imbue(std::locale("C"));
+        ss.imbue(std::locale::classic());
         switch(n){
             case 2:
                 // block name
@@ -3134,23 +3144,29 @@ void CDxfRead::get_line()
         return;
     }
 
-    m_ifs->getline(m_str, 1024);
+    // Mimic std::istream::getline(), i.e. the end of file is flagged when
+    // the last line is not terminated by a new line character.
+    const char* end = m_buffer.data() + m_buffer.size();
+    const char* p = m_pos;
+    const char* eol = 0;
+    if(p < end)
+        eol = static_cast<const char*>(memchr(p, '\n', end - p));
+    if(eol)
+        m_pos = eol + 1;
+    else {
+        eol = m_pos = end;
+        m_eof = true;
+    }
 
-    char str[1024];
-    size_t len = strlen(m_str);
-    int j = 0;
-    bool non_white_found = false;
-    for(size_t i = 0; i<len; i++){
-        if(non_white_found || (m_str[i] != ' ' && m_str[i] != '\t')){
-            if(m_str[i] != '\r')
-            {
-                str[j] = m_str[i]; j++;
-            }
-            non_white_found = true;
-        }
+    // skip leading white spaces, and strip all carriage returns
+    while(p < eol && (*p == ' ' || *p == '\t'))
+        ++p;
+    size_t j = 0;
+    for(; p < eol && j < sizeof(m_str) - 1; ++p) {
+        if(*p != '\r')
+            m_str[j++] = *p;
     }
-    str[j] = 0;
-    strcpy(m_str, str);
+    m_str[j] = 0;
 }
 
 void dxf_strncpy(char* dst, const char* src, size_t size)
@@ -3193,7 +3209,7 @@ bool CDxfRead::ReadLayer()
     std::string layername;
     int aci = -1;
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
@@ -3205,7 +3221,7 @@ bool CDxfRead::ReadLayer()
         }
 
         std::istringstream ss;
-        ss.imbue(std::locale("C"));
+        ss.imbue(std::locale::classic());
         switch(n){
             case 0: // next item found, so finish with line
                     if (layername.empty())
@@ -3252,7 +3268,7 @@ void CDxfRead::DoRead(const bool ignore_errors /* = false */ )
 
     get_line();
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         if (!strcmp( m_str, "$INSUNITS" )){
             if (!ReadUnits())return;
@@ -244,7 +244,11 @@ public:
 // derive a class from this and implement it's virtual functions
 class ImportExport CDxfRead{
 private:
-    std::ifstream* m_ifs;
+    // The whole file is read into memory at once, and lines are scanned from
+    // the buffer directly, which is much faster than line by line stream reading.
+    std::vector<char> m_buffer;
+    const char* m_pos;
+    bool m_eof;
 
     bool m_fail;
     char m_str[1024];
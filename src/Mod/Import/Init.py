@@ -50,6 +50,7 @@ for p in (("UseAppPart",True),
           ("ImportHiddenObject",True),
           ("ExportHiddenObject",True),
           ("ExportKeepPlacement",True),
+          ("ExportInstancing",False),
           ("ReduceObjects", False),
           ("ShowProgress", True),
           ("ExpandCompound",True)):
@@ -37,6 +37,9 @@
 #include <Base/Console.h>
 #include <Base/Sequencer.h>
 
+#include <atomic>
+#include <QtConcurrentMap>
+
 using namespace MeshCore;
 using Base::BoundBox3f;
 using Base::BoundBox2d;
@@ -660,8 +663,8 @@ bool MeshAlgorithm::FillupHole(const std::vector<unsigned long>& boundary,
     unsigned long refPoint0 = *(boundary.begin());
     unsigned long refPoint1 = *(boundary.begin()+1);
     if (pP2FStructure) {
-        const std::set<unsigned long>& ring1 = (*pP2FStructure)[refPoint0];
-        const std::set<unsigned long>& ring2 = (*pP2FStructure)[refPoint1];
+        MeshIndexRange ring1 = (*pP2FStructure)[refPoint0];
+        MeshIndexRange ring2 = (*pP2FStructure)[refPoint1];
         std::vector<unsigned long> f_int;
         std::set_intersection(ring1.begin(), ring1.end(), ring2.begin(), ring2.end(),
             std::back_insert_iterator<std::vector<unsigned long> >(f_int));
@@ -1714,28 +1717,170 @@ float MeshAlgorithm::CalculateMinimumGridLength(float fLength, const Base::Bound
 
 // ----------------------------------------------------
 
+void MeshIndexTable::Assign(std::vector<unsigned long>& offsets, std::vector<unsigned long>& indices)
+{
+    _offsets.swap(offsets);
+    _indices.swap(indices);
+    _modified.clear();
+}
+
+void MeshIndexTable::Clear()
+{
+    std::vector<unsigned long>().swap(_offsets);
+    std::vector<unsigned long>().swap(_indices);
+    _modified.clear();
+}
+
+std::vector<unsigned long>& MeshIndexTable::Modify(unsigned long pos)
+{
+    std::map<unsigned long, std::vector<unsigned long> >::iterator it = _modified.find(pos);
+    if (it == _modified.end()) {
+        MeshIndexRange range = (*this)[pos];
+        std::vector<unsigned long> row(range.begin(), range.end());
+        it = _modified.insert(std::make_pair(pos, row)).first;
+    }
+    return it->second;
+}
+
+void MeshIndexTable::Insert(unsigned long pos, unsigned long index)
+{
+    std::vector<unsigned long>& row = Modify(pos);
+    std::vector<unsigned long>::iterator it = std::lower_bound(row.begin(), row.end(), index);
+    if (it == row.end() || *it != index)
+        row.insert(it, index);
+}
+
+void MeshIndexTable::Erase(unsigned long pos, unsigned long index)
+{
+    std::vector<unsigned long>& row = Modify(pos);
+    std::vector<unsigned long>::iterator it = std::lower_bound(row.begin(), row.end(), index);
+    if (it != row.end() && *it == index)
+        row.erase(it);
+}
+
+namespace {
+typedef std::pair<unsigned long, unsigned long> EntryIndex;
+
+// Calls func(first, last) for blocks of the range [0, count), in parallel if there
+// is more than one block
+template <typename Func>
+void processBlocks(std::size_t count, Func func)
+{
+    const std::size_t blockSize = 65536;
+    std::vector<std::pair<std::size_t, std::size_t> > blocks;
+    for (std::size_t i=0; i<count; i+=blockSize)
+        blocks.emplace_back(i, std::min(i + blockSize, count));
+
+    if (blocks.size() == 1) {
+        func(blocks.front().first, blocks.front().second);
+    }
+    else if (blocks.size() > 1) {
+        QtConcurrent::blockingMap(blocks, [&func](const std::pair<std::size_t, std::size_t>& block) {
+            func(block.first, block.second);
+        });
+    }
+}
+
+// Sorts the indices of each entry, removes duplicates and compacts the arrays
+void sortAndCompact(std::vector<unsigned long>& offsets, std::vector<unsigned long>& indices)
+{
+    std::size_t numEntries = offsets.size() - 1;
+    std::vector<unsigned long> sizes(numEntries);
+    processBlocks(numEntries, [&](std::size_t first, std::size_t last) {
+        unsigned long* data = indices.data();
+        for (std::size_t i=first; i<last; i++) {
+            unsigned long* begin = data + offsets[i];
+            unsigned long* end = data + offsets[i+1];
+            std::sort(begin, end);
+            sizes[i] = static_cast<unsigned long>(std::unique(begin, end) - begin);
+        }
+    });
+
+    std::vector<unsigned long> newOffsets(numEntries + 1);
+    newOffsets[0] = 0;
+    for (std::size_t i=0; i<numEntries; i++)
+        newOffsets[i+1] = newOffsets[i] + sizes[i];
+
+    // nothing to do if there were no duplicates
+    if (newOffsets[numEntries] == offsets[numEntries])
+        return;
+
+    std::vector<unsigned long> newIndices(newOffsets[numEntries]);
+    processBlocks(numEntries, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i=first; i<last; i++) {
+            std::copy(indices.begin() + offsets[i], indices.begin() + offsets[i] + sizes[i],
+                      newIndices.begin() + newOffsets[i]);
+        }
+    });
+
+    offsets.swap(newOffsets);
+    indices.swap(newIndices);
+}
+
+// Builds the arrays of a table with numEntries entries from the facets of a mesh.
+// For each facet 'emit' writes up to six (entry, index) pairs to the passed buffer
+// and returns their number. A counting pass determines the size of each entry before
+// the indices are scattered into the flat index array.
+template <typename Emit>
+void buildFromFacets(const MeshFacetArray& rFacets, std::size_t numEntries, Emit emit,
+                     std::vector<unsigned long>& offsets, std::vector<unsigned long>& indices)
+{
+    std::vector<std::atomic<unsigned long> > cursor(numEntries);
+    processBlocks(rFacets.size(), [&](std::size_t first, std::size_t last) {
+        EntryIndex pairs[6];
+        for (std::size_t i=first; i<last; i++) {
+            int num = emit(rFacets[i], static_cast<unsigned long>(i), pairs);
+            for (int j=0; j<num; j++)
+                cursor[pairs[j].first].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    offsets.resize(numEntries + 1);
+    offsets[0] = 0;
+    for (std::size_t i=0; i<numEntries; i++) {
+        offsets[i+1] = offsets[i] + cursor[i].load(std::memory_order_relaxed);
+        cursor[i].store(offsets[i], std::memory_order_relaxed);
+    }
+
+    indices.resize(offsets[numEntries]);
+    processBlocks(rFacets.size(), [&](std::size_t first, std::size_t last) {
+        EntryIndex pairs[6];
+        for (std::size_t i=first; i<last; i++) {
+            int num = emit(rFacets[i], static_cast<unsigned long>(i), pairs);
+            for (int j=0; j<num; j++)
+                indices[cursor[pairs[j].first].fetch_add(1, std::memory_order_relaxed)] = pairs[j].second;
+        }
+    });
+
+    sortAndCompact(offsets, indices);
+}
+}
+
+// ----------------------------------------------------
+
 void MeshRefPointToFacets::Rebuild (void)
 {
-    _map.clear();
+    _map.Clear();
 
     const MeshPointArray& rPoints = _rclMesh.GetPoints();
     const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    _map.resize(rPoints.size());
 
-    MeshFacetArray::_TConstIterator pFBegin = rFacets.begin();
-    for (MeshFacetArray::_TConstIterator pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter) {
-        _map[pFIter->_aulPoints[0]].insert(pFIter - pFBegin);
-        _map[pFIter->_aulPoints[1]].insert(pFIter - pFBegin);
-        _map[pFIter->_aulPoints[2]].insert(pFIter - pFBegin);
-    }
+    std::vector<unsigned long> offsets, indices;
+    buildFromFacets(rFacets, rPoints.size(),
+                    [](const MeshFacet& rFacet, unsigned long index, EntryIndex* pairs) -> int {
+        for (int i = 0; i < 3; i++)
+            pairs[i] = std::make_pair(rFacet._aulPoints[i], index);
+        return 3;
+    }, offsets, indices);
+    _map.Assign(offsets, indices);
 }
 
 Base::Vector3f MeshRefPointToFacets::GetNormal(unsigned long pos) const
 {
-    const std::set<unsigned long>& n = _map[pos];
+    MeshIndexRange n = _map[pos];
     Base::Vector3f normal;
     MeshGeomFacet f;
-    for (std::set<unsigned long>::const_iterator it = n.begin(); it != n.end(); ++it) {
+    for (MeshIndexRange::const_iterator it = n.begin(); it != n.end(); ++it) {
         f = _rclMesh.GetFacet(*it);
         normal += f.Area() * f.GetNormal();
     }
@@ -1753,8 +1898,8 @@ std::set<unsigned long> MeshRefPointToFacets::NeighbourPoints(const std::vector<
     for (int i=0; i < level; i++) {
         std::set<unsigned long> cur;
         for (std::set<unsigned long>::iterator it = lp.begin(); it != lp.end(); ++it) {
-            const std::set<unsigned long>& ft = (*this)[*it];
-            for (std::set<unsigned long>::const_iterator jt = ft.begin(); jt != ft.end(); ++jt) {
+            MeshIndexRange ft = (*this)[*it];
+            for (MeshIndexRange::const_iterator jt = ft.begin(); jt != ft.end(); ++jt) {
                 for (int j = 0; j < 3; j++) {
                     unsigned long index = f_it[*jt]._aulPoints[j];
                     if (cp.find(index) == cp.end() && nb.find(index) == nb.end()) {
@@ -1775,8 +1920,8 @@ std::set<unsigned long> MeshRefPointToFacets::NeighbourPoints(const std::vector<
 std::set<unsigned long> MeshRefPointToFacets::NeighbourPoints(unsigned long pos) const
 {
     std::set<unsigned long> p;
-    const std::set<unsigned long>& vf = _map[pos];
-    for (std::set<unsigned long>::const_iterator it = vf.begin(); it != vf.end(); ++it) {
+    MeshIndexRange vf = _map[pos];
+    for (MeshIndexRange::const_iterator it = vf.begin(); it != vf.end(); ++it) {
         unsigned long p1, p2, p3;
         _rclMesh.GetFacetPoints(*it, p1, p2, p3);
         if (p1 != pos)
@@ -1812,9 +1957,9 @@ void MeshRefPointToFacets::SearchNeighbours(const MeshFacetArray& rFacets, unsig
     visited.insert(index);
     collect.Append(_rclMesh, index);
     for (int i = 0; i < 3; i++) {
-        const std::set<unsigned long> &f = (*this)[face._aulPoints[i]];
+        MeshIndexRange f = (*this)[face._aulPoints[i]];
 
-        for (std::set<unsigned long>::const_iterator j = f.begin(); j != f.end(); ++j) {
+        for (MeshIndexRange::const_iterator j = f.begin(); j != f.end(); ++j) {
             SearchNeighbours(rFacets, *j, rclCenter, fMaxDist2, visited, collect);
         }
     }
@@ -1826,7 +1971,7 @@ MeshRefPointToFacets::GetFacet (unsigned long index) const
     return _rclMesh.GetFacets().begin() + index;
 }
 
-const std::set<unsigned long>&
+MeshIndexRange
 MeshRefPointToFacets::operator[] (unsigned long pos) const
 {
     return _map[pos];
@@ -1837,8 +1982,8 @@ MeshRefPointToFacets::GetIndices(unsigned long pos1, unsigned long pos2) const
 {
     std::vector<unsigned long> intersection;
     std::back_insert_iterator<std::vector<unsigned long> > result(intersection);
-    const std::set<unsigned long>& set1 = _map[pos1];
-    const std::set<unsigned long>& set2 = _map[pos2];
+    MeshIndexRange set1 = _map[pos1];
+    MeshIndexRange set2 = _map[pos2];
     std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), result);
     return intersection;
 }
@@ -1849,19 +1994,19 @@ MeshRefPointToFacets::GetIndices(unsigned long pos1, unsigned long pos2, unsigne
     std::vector<unsigned long> intersection;
     std::back_insert_iterator<std::vector<unsigned long> > result(intersection);
     std::vector<unsigned long> set1 = GetIndices(pos1, pos2);
-    const std::set<unsigned long>& set2 = _map[pos3];
+    MeshIndexRange set2 = _map[pos3];
     std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), result);
     return intersection;
 }
 
 void MeshRefPointToFacets::AddNeighbour(unsigned long pos, unsigned long facet)
 {
-    _map[pos].insert(facet);
+    _map.Insert(pos, facet);
 }
 
 void MeshRefPointToFacets::RemoveNeighbour(unsigned long pos, unsigned long facet)
 {
-    _map[pos].erase(facet);
+    _map.Erase(pos, facet);
 }
 
 void MeshRefPointToFacets::RemoveFacet(unsigned long facetIndex)
@@ -1869,32 +2014,52 @@ void MeshRefPointToFacets::RemoveFacet(unsigned long facetIndex)
     unsigned long p0, p1, p2;
     _rclMesh.GetFacetPoints(facetIndex, p0, p1, p2);
 
-    _map[p0].erase(facetIndex);
-    _map[p1].erase(facetIndex);
-    _map[p2].erase(facetIndex);
+    _map.Erase(p0, facetIndex);
+    _map.Erase(p1, facetIndex);
+    _map.Erase(p2, facetIndex);
 }
 
 //----------------------------------------------------------------------------
 
 void MeshRefFacetToFacets::Rebuild (void)
 {
-    _map.clear();
+    _map.Clear();
 
     const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    _map.resize(rFacets.size());
-
+    std::size_t numFacets = rFacets.size();
     MeshRefPointToFacets  vertexFace(_rclMesh);
-    MeshFacetArray::_TConstIterator pFBegin = rFacets.begin();
-    for (MeshFacetArray::_TConstIterator pFIter = pFBegin; pFIter != rFacets.end(); ++pFIter) {
-        for (int i = 0; i < 3; i++) {
-            const std::set<unsigned long>& faces = vertexFace[pFIter->_aulPoints[i]];
-            for (std::set<unsigned long>::const_iterator it = faces.begin(); it != faces.end(); ++it)
-                _map[pFIter - pFBegin].insert(*it);
+
+    // a facet is adjacent to all facets of its three corners
+    std::vector<unsigned long> offsets(numFacets + 1), indices;
+    offsets[0] = 0;
+    processBlocks(numFacets, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i=first; i<last; i++) {
+            const MeshFacet& rFacet = rFacets[i];
+            offsets[i+1] = vertexFace[rFacet._aulPoints[0]].size()
+                         + vertexFace[rFacet._aulPoints[1]].size()
+                         + vertexFace[rFacet._aulPoints[2]].size();
         }
-    }
+    });
+
+    for (std::size_t i=0; i<numFacets; i++)
+        offsets[i+1] += offsets[i];
+
+    indices.resize(offsets[numFacets]);
+    processBlocks(numFacets, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i=first; i<last; i++) {
+            std::vector<unsigned long>::iterator it = indices.begin() + offsets[i];
+            for (int j = 0; j < 3; j++) {
+                MeshIndexRange faces = vertexFace[rFacets[i]._aulPoints[j]];
+                it = std::copy(faces.begin(), faces.end(), it);
+            }
+        }
+    });
+
+    sortAndCompact(offsets, indices);
+    _map.Assign(offsets, indices);
 }
 
-const std::set<unsigned long>&
+MeshIndexRange
 MeshRefFacetToFacets::operator[] (unsigned long pos) const
 {
     return _map[pos];
@@ -1905,8 +2070,8 @@ MeshRefFacetToFacets::GetIndices(unsigned long pos1, unsigned long pos2) const
 {
     std::vector<unsigned long> intersection;
     std::back_insert_iterator<std::vector<unsigned long> > result(intersection);
-    const std::set<unsigned long>& set1 = _map[pos1];
-    const std::set<unsigned long>& set2 = _map[pos2];
+    MeshIndexRange set1 = _map[pos1];
+    MeshIndexRange set2 = _map[pos2];
     std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), result);
     return intersection;
 }
@@ -1915,24 +2080,27 @@ MeshRefFacetToFacets::GetIndices(unsigned long pos1, unsigned long pos2) const
 
 void MeshRefPointToPoints::Rebuild (void)
 {
-    _map.clear();
+    _map.Clear();
 
     const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    _map.resize(rPoints.size());
-
     const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    for (MeshFacetArray::_TConstIterator pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter) {
-        unsigned long ulP0 = pFIter->_aulPoints[0];
-        unsigned long ulP1 = pFIter->_aulPoints[1];
-        unsigned long ulP2 = pFIter->_aulPoints[2];
 
-        _map[ulP0].insert(ulP1);
-        _map[ulP0].insert(ulP2);
-        _map[ulP1].insert(ulP0);
-        _map[ulP1].insert(ulP2);
-        _map[ulP2].insert(ulP0);
-        _map[ulP2].insert(ulP1);
-    }
+    std::vector<unsigned long> offsets, indices;
+    buildFromFacets(rFacets, rPoints.size(),
+                    [](const MeshFacet& rFacet, unsigned long, EntryIndex* pairs) -> int {
+        unsigned long ulP0 = rFacet._aulPoints[0];
+        unsigned long ulP1 = rFacet._aulPoints[1];
+        unsigned long ulP2 = rFacet._aulPoints[2];
+
+        pairs[0] = std::make_pair(ulP0, ulP1);
+        pairs[1] = std::make_pair(ulP0, ulP2);
+        pairs[2] = std::make_pair(ulP1, ulP0);
+        pairs[3] = std::make_pair(ulP1, ulP2);
+        pairs[4] = std::make_pair(ulP2, ulP0);
+        pairs[5] = std::make_pair(ulP2, ulP1);
+        return 6;
+    }, offsets, indices);
+    _map.Assign(offsets, indices);
 }
 
 Base::Vector3f MeshRefPointToPoints::GetNormal(unsigned long pos) const
@@ -1941,8 +2109,8 @@ Base::Vector3f MeshRefPointToPoints::GetNormal(unsigned long pos) const
     MeshCore::PlaneFit pf;
     pf.AddPoint(rPoints[pos]);
     MeshCore::MeshPoint center = rPoints[pos];
-    const std::set<unsigned long>& cv = _map[pos];
-    for (std::set<unsigned long>::const_iterator cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
+    MeshIndexRange cv = _map[pos];
+    for (MeshIndexRange::const_iterator cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
         pf.AddPoint(rPoints[*cv_it]);
         center += rPoints[*cv_it];
     }
@@ -1958,15 +2126,15 @@ float MeshRefPointToPoints::GetAverageEdgeLength(unsigned long index) const
 {
     const MeshPointArray& rPoints = _rclMesh.GetPoints();
     float len=0.0f;
-    const std::set<unsigned long>& n = (*this)[index];
+    MeshIndexRange n = (*this)[index];
     const Base::Vector3f& p = rPoints[index];
-    for (std::set<unsigned long>::const_iterator it = n.begin(); it != n.end(); ++it) {
+    for (MeshIndexRange::const_iterator it = n.begin(); it != n.end(); ++it) {
         len += Base::Distance(p, rPoints[*it]);
     }
     return (len/n.size());
 }
 
-const std::set<unsigned long>&
+MeshIndexRange
 MeshRefPointToPoints::operator[] (unsigned long pos) const
 {
     return _map[pos];
@@ -1974,12 +2142,12 @@ MeshRefPointToPoints::operator[] (unsigned long pos) const
 
 void MeshRefPointToPoints::AddNeighbour(unsigned long pos, unsigned long facet)
 {
-    _map[pos].insert(facet);
+    _map.Insert(pos, facet);
 }
 
 void MeshRefPointToPoints::RemoveNeighbour(unsigned long pos, unsigned long facet)
 {
-    _map[pos].erase(facet);
+    _map.Erase(pos, facet);
 }
 
 //----------------------------------------------------------------------------
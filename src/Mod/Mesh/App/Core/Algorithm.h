@@ -24,6 +24,7 @@
 #ifndef MESHALGORITHM_H
 #define MESHALGORITHM_H
 
+#include <algorithm>
 #include <set>
 #include <vector>
 #include <map>
@@ -362,6 +363,81 @@ private:
     std::vector<unsigned long>& indices;
 };
 
+/**
+ * The MeshIndexRange is a read-only view of a sorted list of indices as returned by
+ * the adjacency structures below. It offers the part of the std::set interface that
+ * is needed to iterate over the indices or to look up an index.
+ * \note The range becomes invalid if the structure it was taken from is rebuilt or
+ * modified.
+ */
+class MeshIndexRange
+{
+public:
+    typedef const unsigned long* const_iterator;
+    typedef const_iterator iterator;
+    typedef unsigned long value_type;
+    typedef std::size_t size_type;
+
+    MeshIndexRange() : _begin(0), _end(0)
+    { }
+    MeshIndexRange(const_iterator first, const_iterator last) : _begin(first), _end(last)
+    { }
+
+    const_iterator begin() const
+    { return _begin; }
+    const_iterator end() const
+    { return _end; }
+    size_type size() const
+    { return static_cast<size_type>(_end - _begin); }
+    bool empty() const
+    { return _begin == _end; }
+    /// Returns the position of \a index or end() if the range doesn't contain it.
+    const_iterator find(unsigned long index) const
+    {
+        const_iterator it = std::lower_bound(_begin, _end, index);
+        return (it != _end && *it == index) ? it : _end;
+    }
+    size_type count(unsigned long index) const
+    { return find(index) != _end ? 1 : 0; }
+
+private:
+    const_iterator _begin, _end;
+};
+
+/**
+ * The MeshIndexTable keeps a sorted list of indices for each entry in two flat arrays.
+ * The indices of entry \a i are stored in the range [offsets[i], offsets[i+1]) of
+ * the index array. Entries that are modified after building the table are moved
+ * to a separate map.
+ */
+class MeshExport MeshIndexTable
+{
+public:
+    /// Takes over the content of the passed arrays.
+    void Assign(std::vector<unsigned long>& offsets, std::vector<unsigned long>& indices);
+    void Clear();
+    MeshIndexRange operator[] (unsigned long pos) const
+    {
+        if (!_modified.empty()) {
+            std::map<unsigned long, std::vector<unsigned long> >::const_iterator it = _modified.find(pos);
+            if (it != _modified.end())
+                return MeshIndexRange(it->second.data(), it->second.data() + it->second.size());
+        }
+        const unsigned long* data = _indices.data();
+        return MeshIndexRange(data + _offsets[pos], data + _offsets[pos+1]);
+    }
+    void Insert(unsigned long pos, unsigned long index);
+    void Erase(unsigned long pos, unsigned long index);
+
+private:
+    std::vector<unsigned long>& Modify(unsigned long pos);
+
+private:
+    std::vector<unsigned long> _offsets;
+    std::vector<unsigned long> _indices;
+    std::map<unsigned long, std::vector<unsigned long> > _modified;
+};
+
 /**
  * The MeshRefPointToFacets builds up a structure to have access to all facets indexing
  * a point.
@@ -380,7 +456,7 @@ public:
 
     /// Rebuilds up data structure
     void Rebuild (void);
-    const std::set<unsigned long>& operator[] (unsigned long) const;
+    MeshIndexRange operator[] (unsigned long) const;
     std::vector<unsigned long> GetIndices(unsigned long, unsigned long) const;
     std::vector<unsigned long> GetIndices(unsigned long, unsigned long, unsigned long) const;
     MeshFacetArray::_TConstIterator GetFacet (unsigned long) const;
@@ -398,7 +474,7 @@ protected:
 
 protected:
     const MeshKernel  &_rclMesh; /**< The mesh kernel. */
-    std::vector<std::set<unsigned long> > _map;
+    MeshIndexTable    _map;  /**< The sorted indices of each entry. */
 };
 
 /**
@@ -421,13 +497,13 @@ public:
 
     /// Returns a set of facets sharing one or more points with the facet with
     /// index \a ulFacetIndex.
-    const std::set<unsigned long>& operator[] (unsigned long) const;
+    MeshIndexRange operator[] (unsigned long) const;
     /// Returns an array of common facets of the passed facet indexes.
     std::vector<unsigned long> GetIndices(unsigned long, unsigned long) const;
 
 protected:
     const MeshKernel  &_rclMesh; /**< The mesh kernel. */
-    std::vector<std::set<unsigned long> > _map;
+    MeshIndexTable    _map;  /**< The sorted indices of each entry. */
 };
 
 /**
@@ -448,7 +524,7 @@ public:
 
     /// Rebuilds up data structure
     void Rebuild (void);
-    const std::set<unsigned long>& operator[] (unsigned long) const;
+    MeshIndexRange operator[] (unsigned long) const;
     Base::Vector3f GetNormal(unsigned long) const;
     float GetAverageEdgeLength(unsigned long) const;
     void AddNeighbour(unsigned long, unsigned long);
@@ -456,7 +532,7 @@ public:
 
 protected:
     const MeshKernel  &_rclMesh; /**< The mesh kernel. */
-    std::vector<std::set<unsigned long> > _map;
+    MeshIndexTable    _map;  /**< The sorted indices of each entry. */
 };
 
 /**
@@ -152,23 +152,17 @@ PlaneFit::~PlaneFit()
 {
 }
 
-float PlaneFit::Fit()
+namespace {
+/*
+ * Fits a plane into points given by the number of points, the sums of their coordinates
+ * (mx, my, mz) and the sums of the products of their coordinates (sxx, ..., szz). On
+ * success the standard deviation is written to \a sigma.
+ */
+bool fitPlaneToSums(double sxx, double sxy, double sxz, double syy, double syz, double szz,
+                    double mx, double my, double mz, size_t nSize,
+                    Base::Vector3f& base, Base::Vector3f& dirU, Base::Vector3f& dirV,
+                    Base::Vector3f& dirW, float& sigma)
 {
-    _bIsFitted = true;
-    if (CountPoints() < 3)
-        return FLOAT_MAX;
-
-    double sxx,sxy,sxz,syy,syz,szz,mx,my,mz;
-    sxx=sxy=sxz=syy=syz=szz=mx=my=mz=0.0;
-
-    for (std::list<Base::Vector3f>::iterator it = _vPoints.begin(); it!=_vPoints.end(); ++it) {
-        sxx += double(it->x * it->x); sxy += double(it->x * it->y);
-        sxz += double(it->x * it->z); syy += double(it->y * it->y);
-        syz += double(it->y * it->z); szz += double(it->z * it->z);
-        mx  += double(it->x); my += double(it->y); mz += double(it->z);
-    }
-
-    size_t nSize = _vPoints.size();
     sxx = sxx - mx*mx/(double(nSize));
     sxy = sxy - mx*my/(double(nSize));
     sxz = sxz - mx*mz/(double(nSize));
@@ -190,12 +184,12 @@ float PlaneFit::Fit()
     Eigen::Vector3d v = eig.eigenvectors().col(2);
     Eigen::Vector3d w = eig.eigenvectors().col(0);
 
-    _vDirU.Set(u.x(), u.y(), u.z());
-    _vDirV.Set(v.x(), v.y(), v.z());
-    _vDirW.Set(w.x(), w.y(), w.z());
-    _vBase.Set(mx/(float)nSize, my/(float)nSize, mz/(float)nSize);
+    dirU.Set(u.x(), u.y(), u.z());
+    dirV.Set(v.x(), v.y(), v.z());
+    dirW.Set(w.x(), w.y(), w.z());
+    base.Set(mx/(float)nSize, my/(float)nSize, mz/(float)nSize);
 
-    float sigma = w.dot(covMat * w);
+    sigma = w.dot(covMat * w);
 #else
     // Covariance matrix
     Wm4::Matrix3<double> akMat(sxx,sxy,sxz,sxy,syy,syz,sxz,syz,szz);
@@ -204,7 +198,7 @@ float PlaneFit::Fit()
         akMat.EigenDecomposition(rkRot, rkDiag);
     }
     catch (const std::exception&) {
-        return FLOAT_MAX;
+        return false;
     }
 
     // We know the Eigenvalues are ordered
@@ -212,7 +206,7 @@ float PlaneFit::Fit()
     //
     // points describe a line or even are identical
     if (rkDiag(1,1) <= 0)
-        return FLOAT_MAX;
+        return false;
 
     Wm4::Vector3<double> U = rkRot.GetColumn(1);
     Wm4::Vector3<double> V = rkRot.GetColumn(2);
@@ -223,19 +217,19 @@ float PlaneFit::Fit()
         if (boost::math::isnan(U[i]) || 
             boost::math::isnan(V[i]) ||
             boost::math::isnan(W[i]))
-            return FLOAT_MAX;
+            return false;
     }
 
-    _vDirU.Set(float(U.X()), float(U.Y()), float(U.Z()));
-    _vDirV.Set(float(V.X()), float(V.Y()), float(V.Z()));
-    _vDirW.Set(float(W.X()), float(W.Y()), float(W.Z()));
-    _vBase.Set(float(mx/nSize), float(my/nSize), float(mz/nSize));
-    float sigma = float(W.Dot(akMat * W));
+    dirU.Set(float(U.X()), float(U.Y()), float(U.Z()));
+    dirV.Set(float(V.X()), float(V.Y()), float(V.Z()));
+    dirW.Set(float(W.X()), float(W.Y()), float(W.Z()));
+    base.Set(float(mx/nSize), float(my/nSize), float(mz/nSize));
+    sigma = float(W.Dot(akMat * W));
 #endif
 
     // In case sigma is nan
     if (boost::math::isnan(sigma))
-        return FLOAT_MAX;
+        return false;
 
     // This must be caused by some round-off errors. Theoretically it's impossible
     // that 'sigma' becomes negative because the covariance matrix is positive semi-definite.
@@ -243,10 +237,10 @@ float PlaneFit::Fit()
         sigma = 0;
 
     // make a right-handed system
-    if ((_vDirU % _vDirV) * _vDirW < 0.0f) {
-        Base::Vector3f tmp = _vDirU;
-        _vDirU = _vDirV;
-        _vDirV = tmp;
+    if ((dirU % dirV) * dirW < 0.0f) {
+        Base::Vector3f tmp = dirU;
+        dirU = dirV;
+        dirV = tmp;
     }
 
     if (nSize > 3)
@@ -254,6 +248,31 @@ float PlaneFit::Fit()
     else
         sigma = 0;
 
+    return true;
+}
+}
+
+float PlaneFit::Fit()
+{
+    _bIsFitted = true;
+    if (CountPoints() < 3)
+        return FLOAT_MAX;
+
+    double sxx,sxy,sxz,syy,syz,szz,mx,my,mz;
+    sxx=sxy=sxz=syy=syz=szz=mx=my=mz=0.0;
+
+    for (std::list<Base::Vector3f>::iterator it = _vPoints.begin(); it!=_vPoints.end(); ++it) {
+        sxx += double(it->x * it->x); sxy += double(it->x * it->y);
+        sxz += double(it->x * it->z); syy += double(it->y * it->y);
+        syz += double(it->y * it->z); szz += double(it->z * it->z);
+        mx  += double(it->x); my += double(it->y); mz += double(it->z);
+    }
+
+    float sigma;
+    if (!fitPlaneToSums(sxx, sxy, sxz, syy, syz, szz, mx, my, mz, _vPoints.size(),
+                        _vBase, _vDirU, _vDirV, _vDirW, sigma))
+        return FLOAT_MAX;
+
     _fLastResult = sigma;
     return _fLastResult;
 }
@@ -425,6 +444,78 @@ Base::BoundBox3f PlaneFit::GetBoundings() const
 
 // -------------------------------------------------------------------------------
 
+IncrementalPlaneFit::IncrementalPlaneFit()
+  : _sxx(0), _sxy(0), _sxz(0), _syy(0), _syz(0), _szz(0)
+  , _mx(0), _my(0), _mz(0)
+  , _ulNumPoints(0)
+  , _bIsFitted(false)
+  , _fLastResult(FLOAT_MAX)
+  , _vBase(0,0,0)
+  , _vDirU(1,0,0)
+  , _vDirV(0,1,0)
+  , _vDirW(0,0,1)
+{
+}
+
+void IncrementalPlaneFit::Clear()
+{
+    _sxx=_sxy=_sxz=_syy=_syz=_szz=_mx=_my=_mz=0.0;
+    _ulNumPoints = 0;
+    _bIsFitted = false;
+}
+
+void IncrementalPlaneFit::AddPoint(const Base::Vector3f &rcVector)
+{
+    // same accumulation as in PlaneFit::Fit() so that both give identical results
+    _sxx += double(rcVector.x * rcVector.x); _sxy += double(rcVector.x * rcVector.y);
+    _sxz += double(rcVector.x * rcVector.z); _syy += double(rcVector.y * rcVector.y);
+    _syz += double(rcVector.y * rcVector.z); _szz += double(rcVector.z * rcVector.z);
+    _mx  += double(rcVector.x); _my += double(rcVector.y); _mz += double(rcVector.z);
+    _ulNumPoints++;
+    _bIsFitted = false;
+}
+
+float IncrementalPlaneFit::Fit()
+{
+    _bIsFitted = true;
+    if (_ulNumPoints < 3)
+        return FLOAT_MAX;
+
+    float sigma;
+    if (!fitPlaneToSums(_sxx, _sxy, _sxz, _syy, _syz, _szz, _mx, _my, _mz, _ulNumPoints,
+                        _vBase, _vDirU, _vDirV, _vDirW, sigma))
+        return FLOAT_MAX;
+
+    _fLastResult = sigma;
+    return _fLastResult;
+}
+
+Base::Vector3f IncrementalPlaneFit::GetBase() const
+{
+    if (_bIsFitted)
+        return _vBase;
+    else
+        return Base::Vector3f();
+}
+
+Base::Vector3f IncrementalPlaneFit::GetNormal() const
+{
+    if (_bIsFitted)
+        return _vDirW;
+    else
+        return Base::Vector3f();
+}
+
+float IncrementalPlaneFit::GetDistanceToPlane(const Base::Vector3f &rcPoint) const
+{
+    float fResult = FLOAT_MAX;
+    if (_bIsFitted)
+        fResult = (rcPoint - _vBase) * _vDirW;
+    return fResult;
+}
+
+// -------------------------------------------------------------------------------
+
 bool QuadraticFit::GetCurvatureInfo(double x, double y, double z,
                                     double &rfCurv0, double &rfCurv1,
                                     Base::Vector3f &rkDir0, Base::Vector3f &rkDir1, double &dDistance)
@@ -250,6 +250,62 @@ protected:
 
 // -------------------------------------------------------------------------------
 
+/**
+ * Approximation of a plane into a growing set of points. Unlike PlaneFit the points
+ * are not kept but only the sums of their coordinates and of their products. This
+ * way a refit after adding further points doesn't need to go through all points again.
+ */
+class MeshExport IncrementalPlaneFit
+{
+public:
+    IncrementalPlaneFit();
+    /**
+     * Removes all points.
+     */
+    void Clear();
+    /**
+     * Adds a point to the fit.
+     */
+    void AddPoint(const Base::Vector3f &rcVector);
+    /**
+     * Returns the number of added points.
+     */
+    unsigned long CountPoints() const { return _ulNumPoints; }
+    /**
+     * Returns true if Fit() has been called after adding the last point.
+     */
+    bool Done() const { return _bIsFitted; }
+    /**
+     * Fit a plane into the added points. We must have at least three non-collinear points
+     * to succeed. If the fit fails FLOAT_MAX is returned.
+     */
+    float Fit();
+    Base::Vector3f GetBase() const;
+    /**
+     * Returns the normal of the fitted plane. If Fit() has not been called the null vector is
+     * returned.
+     */
+    Base::Vector3f GetNormal() const;
+    /**
+     * Returns the distance from the point \a rcPoint to the fitted plane. If Fit() has not been
+     * called FLOAT_MAX is returned.
+     */
+    float GetDistanceToPlane(const Base::Vector3f &rcPoint) const;
+
+private:
+    double _sxx, _sxy, _sxz, _syy, _syz, _szz; /**< Sums of the coordinate products. */
+    double _mx, _my, _mz; /**< Sums of the coordinates. */
+    unsigned long _ulNumPoints;
+    bool _bIsFitted;
+    float _fLastResult;
+    Base::Vector3f _vBase;
+    Base::Vector3f _vDirU;
+    Base::Vector3f _vDirV;
+    Base::Vector3f _vDirW;
+};
+
+// -------------------------------------------------------------------------------
+
 /**
  * Approximation of a quadratic surface into a given set of points. The implicit form of the surface
  * is defined by F(x,y,z) = a * x^2 + b * y^2 + c * z^2 + 
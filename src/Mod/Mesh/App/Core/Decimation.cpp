@@ -30,14 +30,22 @@
 #include "Algorithm.h"
 #include "Iterator.h"
 #include "TopoAlgorithm.h"
+#include "Functional.h"
+#include "Grid.h"
 #include <Base/Tools.h>
 #include "Simplify.h"
 
+#include <unordered_map>
+#include <QtConcurrentMap>
+
 
 using namespace MeshCore;
 
 MeshSimplify::MeshSimplify(MeshKernel& mesh)
   : myKernel(mesh)
+  , parallel(false)
+  , measureError(false)
+  , hausdorffDistance(-1.0f)
 {
 }
 
@@ -46,6 +54,75 @@ MeshSimplify::~MeshSimplify()
 }
 
 void MeshSimplify::simplify(float tolerance, float reduction)
+{
+    int target_count = static_cast<int>(static_cast<float>(myKernel.CountFacets()) * (1.0f-reduction));
+    simplifyMesh(target_count, tolerance);
+}
+
+void MeshSimplify::simplify(int targetSize)
+{
+    simplifyMesh(targetSize, FLT_MAX);
+}
+
+void MeshSimplify::setParallel(bool on)
+{
+    parallel = on;
+}
+
+void MeshSimplify::setMeasureError(bool on)
+{
+    measureError = on;
+}
+
+float MeshSimplify::getHausdorffDistance() const
+{
+    return hausdorffDistance;
+}
+
+void MeshSimplify::simplifyMesh(int targetSize, double tolerance)
+{
+    MeshPointArray samples;
+    if (measureError)
+        samples = myKernel.GetPoints();
+    hausdorffDistance = -1.0f;
+
+    // Large meshes are split into spatial parts that are simplified concurrently
+    int numParts = 1;
+    if (parallel) {
+        const unsigned long minFacetsPerPart = 100000;
+        numParts = std::min<unsigned long>(std::max(1, QThread::idealThreadCount()),
+                                           myKernel.CountFacets() / minFacetsPerPart);
+    }
+
+    if (numParts > 1)
+        simplifyPartitioned(targetSize, tolerance, numParts);
+    else
+        simplifySerial(targetSize, tolerance);
+
+    if (measureError)
+        hausdorffDistance = measureDistance(samples);
+}
+
+float MeshSimplify::measureDistance(const MeshPointArray& samples) const
+{
+    // One-sided Hausdorff distance sampled at the input points
+    if (myKernel.CountFacets() == 0)
+        return -1.0f;
+
+    MeshFacetGrid grid(myKernel);
+    MeshAlgorithm alg(myKernel);
+    float distance = 0.0f;
+    unsigned long facet;
+    Base::Vector3f nearest;
+    for (const MeshPoint& p : samples) {
+        if (alg.NearestPointFromPoint(p, grid, facet, nearest))
+            distance = std::max(distance, Base::Distance(p, nearest));
+    }
+
+    return distance;
+}
+
+void MeshSimplify::simplifySerial(int targetSize, double tolerance)
 {
     Simplify alg;
 
@@ -64,10 +141,8 @@ void MeshSimplify::simplify(float tolerance, float reduction)
         alg.triangles.push_back(t);
     }
 
-    int target_count = static_cast<int>(static_cast<float>(facets.size()) * (1.0f-reduction));
-
     // Simplification starts
-    alg.simplify_mesh(target_count, tolerance);
+    alg.simplify_mesh(targetSize, tolerance);
 
     // Simplification done
     MeshPointArray new_points;
@@ -96,49 +171,119 @@ void MeshSimplify::simplify(float tolerance, float reduction)
     myKernel.Adopt(new_points, new_facets, true);
 }
 
-void MeshSimplify::simplify(int targetSize)
+void MeshSimplify::simplifyPartitioned(int targetSize, double tolerance, int numParts)
 {
-    Simplify alg;
-
     const MeshPointArray& points = myKernel.GetPoints();
-    for (std::size_t i = 0; i < points.size(); i++) {
-        Simplify::Vertex v;
-        v.p = points[i];
-        alg.vertices.push_back(v);
-    }
-
     const MeshFacetArray& facets = myKernel.GetFacets();
-    for (std::size_t i = 0; i < facets.size(); i++) {
-        Simplify::Triangle t;
-        for (int j = 0; j < 3; j++)
-            t.v[j] = facets[i]._aulPoints[j];
-        alg.triangles.push_back(t);
-    }
+    std::size_t numFacets = facets.size();
 
-    // Simplification starts
-    alg.simplify_mesh(targetSize, FLT_MAX);
+    // Sort the facets along the longest side of the bounding box
+    const Base::BoundBox3f& bbox = myKernel.GetBoundBox();
+    unsigned short axis = 0;
+    if (bbox.LengthY() > bbox.LengthX())
+        axis = 1;
+    if (bbox.LengthZ() > std::max(bbox.LengthX(), bbox.LengthY()))
+        axis = 2;
 
-    // Simplification done
-    MeshPointArray new_points;
-    new_points.reserve(alg.vertices.size());
-    for (std::size_t i = 0; i < alg.vertices.size(); i++) {
-        new_points.push_back(alg.vertices[i].p);
+    std::vector<std::pair<float, unsigned long> > order;
+    order.reserve(numFacets);
+    for (std::size_t i = 0; i < numFacets; i++) {
+        const MeshFacet& face = facets[i];
+        float center = points[face._aulPoints[0]][axis] +
+                       points[face._aulPoints[1]][axis] +
+                       points[face._aulPoints[2]][axis];
+        order.emplace_back(center, i);
     }
+    MeshCore::parallel_sort(order.begin(), order.end(),
+                            std::less<std::pair<float, unsigned long> >(), numParts);
 
-    std::size_t numFacets = 0;
-    for (std::size_t i = 0; i < alg.triangles.size(); i++) {
-        if (!alg.triangles[i].deleted)
-            numFacets++;
+    // Split them into parts of equal size. Points used by facets of different
+    // parts lie on the seams and must not be touched by the simplification.
+    struct Part {
+        std::vector<unsigned long> facets;
+        Simplify alg;
+    };
+
+    const int shared = -2;
+    std::vector<int> pointPart(points.size(), -1);
+    std::vector<Part> parts(numParts);
+    for (int p = 0; p < numParts; p++) {
+        std::size_t first = numFacets * p / numParts;
+        std::size_t last = numFacets * (p + 1) / numParts;
+        std::vector<unsigned long>& indices = parts[p].facets;
+        indices.reserve(last - first);
+        for (std::size_t i = first; i < last; i++) {
+            unsigned long index = order[i].second;
+            indices.push_back(index);
+            for (int j = 0; j < 3; j++) {
+                int& part = pointPart[facets[index]._aulPoints[j]];
+                if (part == -1)
+                    part = p;
+                else if (part != p)
+                    part = shared;
+            }
+        }
     }
+    order.clear();
+    order.shrink_to_fit();
+
+    QtConcurrent::blockingMap(parts, [&](Part& part) {
+        Simplify& alg = part.alg;
+        std::unordered_map<unsigned long, int> localIndex;
+        localIndex.reserve(part.facets.size());
+        alg.triangles.reserve(part.facets.size());
+        for (unsigned long index : part.facets) {
+            Simplify::Triangle t;
+            for (int j = 0; j < 3; j++) {
+                unsigned long pointIndex = facets[index]._aulPoints[j];
+                auto it = localIndex.emplace(pointIndex, static_cast<int>(alg.vertices.size()));
+                if (it.second) {
+                    Simplify::Vertex v;
+                    v.p = points[pointIndex];
+                    // tag locked points with their index to stitch the parts together
+                    if (pointPart[pointIndex] == shared)
+                        v.locked = pointIndex + 1;
+                    alg.vertices.push_back(v);
+                }
+                t.v[j] = it.first->second;
+            }
+            alg.triangles.push_back(t);
+        }
+
+        int target = static_cast<int>(static_cast<double>(targetSize) * part.facets.size() / numFacets);
+        std::vector<unsigned long>().swap(part.facets);
+        alg.simplify_mesh(target, tolerance);
+    });
+
+    // Stitch the parts together using the locked points
+    MeshPointArray new_points;
     MeshFacetArray new_facets;
-    new_facets.reserve(numFacets);
-    for (std::size_t i = 0; i < alg.triangles.size(); i++) {
-        if (!alg.triangles[i].deleted) {
-            MeshFacet face;
-            face._aulPoints[0] = alg.triangles[i].v[0];
-            face._aulPoints[1] = alg.triangles[i].v[1];
-            face._aulPoints[2] = alg.triangles[i].v[2];
-            new_facets.push_back(face);
+    std::unordered_map<unsigned long, unsigned long> lockedIndex;
+    for (const Part& part : parts) {
+        const Simplify& alg = part.alg;
+        std::vector<unsigned long> pointIndex(alg.vertices.size());
+        for (std::size_t i = 0; i < alg.vertices.size(); i++) {
+            const Simplify::Vertex& v = alg.vertices[i];
+            if (v.locked) {
+                auto it = lockedIndex.emplace(v.locked, new_points.size());
+                if (it.second)
+                    new_points.push_back(v.p);
+                pointIndex[i] = it.first->second;
+            }
+            else {
+                pointIndex[i] = new_points.size();
+                new_points.push_back(v.p);
+            }
+        }
+
+        for (std::size_t i = 0; i < alg.triangles.size(); i++) {
+            if (!alg.triangles[i].deleted) {
+                MeshFacet face;
+                face._aulPoints[0] = pointIndex[alg.triangles[i].v[0]];
+                face._aulPoints[1] = pointIndex[alg.triangles[i].v[1]];
+                face._aulPoints[2] = pointIndex[alg.triangles[i].v[2]];
+                new_facets.push_back(face);
+            }
         }
     }
 
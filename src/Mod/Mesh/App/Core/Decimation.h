@@ -25,6 +25,8 @@
 #define MESH_DECIMATION_H
 
 
+#include "Elements.h"
+
 namespace MeshCore
 {
 class MeshKernel;
@@ -36,9 +38,30 @@ public:
     ~MeshSimplify();
     void simplify(float tolerance, float reduction);
     void simplify(int targetSize);
+    /** If enabled, large meshes are split into spatial parts that are
+     * simplified concurrently. Off by default.
+     */
+    void setParallel(bool on);
+    /** If enabled, simplify() measures the one-sided Hausdorff distance of the
+     * input mesh to the result. Off by default.
+     */
+    void setMeasureError(bool on);
+    /** Returns the largest distance of an input point to the simplified mesh
+     * as measured by the last call of simplify(), or -1 if it was not measured.
+     */
+    float getHausdorffDistance() const;
+
+private:
+    void simplifyMesh(int targetSize, double tolerance);
+    void simplifySerial(int targetSize, double tolerance);
+    void simplifyPartitioned(int targetSize, double tolerance, int numParts);
+    float measureDistance(const MeshPointArray& samples) const;
 
 private:
     MeshKernel& myKernel;
+    bool parallel;
+    bool measureError;
+    float hausdorffDistance;
 };
 
 } // namespace MeshCore
@@ -42,6 +42,9 @@
 #include "Functional.h"
 #include <Base/Matrix.h>
 
+#include <atomic>
+#include <QtConcurrentMap>
+
 #include <Base/Sequencer.h>
 
 using namespace MeshCore;
@@ -476,10 +479,10 @@ bool MeshEvalPointManifolds::Evaluate ()
     unsigned long ctPoints = _rclMesh.CountPoints();
     for (unsigned long index=0; index < ctPoints; index++) {
         // get the local neighbourhood of the point
-        const std::set<unsigned long>& nf = vf_it[index];
-        const std::set<unsigned long>& np = vv_it[index];
+        MeshIndexRange nf = vf_it[index];
+        MeshIndexRange np = vv_it[index];
 
-        std::set<unsigned long>::size_type sp, sf;
+        MeshIndexRange::size_type sp, sf;
         sp = np.size();
         sf = nf.size();
         // for an inner point the number of adjacent points is equal to the number of shared faces
@@ -593,76 +596,138 @@ bool MeshFixSingleFacet::Fixup ()
 
 // ----------------------------------------------------------------
 
-bool MeshEvalSelfIntersection::Evaluate ()
+namespace MeshCore {
+namespace {
+
+/**
+ * Checks the facets of the cells of a facet grid for self-intersections.
+ * The cells are processed concurrently in batches, between two batches
+ * the progress is reported and the user may cancel the operation.
+ */
+class SelfIntersectionCheck
 {
-    // Contains bounding boxes for every facet 
-    std::vector<Base::BoundBox3f> boxes;
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX, ulGridY, ulGridZ;
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
+    struct Cell
+    {
+        std::vector<unsigned long> facets;
+        std::vector<std::pair<unsigned long, unsigned long> > pairs;
+    };
 
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
+public:
+    SelfIntersectionCheck(const MeshKernel& mesh, bool stopAtFirst)
+      : mesh(mesh), stopAtFirst(stopAtFirst), found(false)
+    {
     }
 
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX*ulGridY*ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        //Get the facet indices, belonging to the current grid unit
-        std::vector<unsigned long> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
+    void Compute(std::vector<std::pair<unsigned long, unsigned long> >& intersection,
+                 bool canAbort)
+    {
+        // Contains bounding boxes for every facet
+        const MeshFacetArray& rFaces = mesh.GetFacets();
+        boxes.reserve(rFaces.size());
+        MeshFacetIterator cMFI(mesh);
+        for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
+            boxes.push_back((*cMFI).GetBoundBox());
+        }
 
-        seq.next();
-        if (aulGridElements.size()==0)
-            continue;
+        // Splits the mesh using grid for speeding up the calculation
+        MeshFacetGrid cMeshFacetGrid(mesh);
+        MeshGridIterator clGridIter(cMeshFacetGrid);
+        std::vector<Cell> cells;
+        for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
+            std::vector<unsigned long> aulGridElements;
+            clGridIter.GetElements(aulGridElements);
+            if (aulGridElements.size() > 1) {
+                cells.emplace_back();
+                cells.back().facets.swap(aulGridElements);
+            }
+        }
+
+        const std::size_t numBatches = 100;
+        std::size_t batchSize = std::max<std::size_t>(1, (cells.size() + numBatches - 1) / numBatches);
+        Base::SequencerLauncher seq("Checking for self-intersections...",
+                                    (cells.size() + batchSize - 1) / batchSize);
+        for (std::size_t i = 0; i < cells.size() && !found; i += batchSize) {
+            auto first = cells.begin() + i;
+            auto last = cells.begin() + std::min(i + batchSize, cells.size());
+            QtConcurrent::blockingMap(first, last, [this](Cell& cell) {
+                checkCell(cell);
+            });
+            seq.next(canAbort);
+        }
 
-        MeshGeomFacet facet1, facet2;
+        // a pair of facets may be reported by several cells
+        std::vector<std::pair<unsigned long, unsigned long> > pairs;
+        for (const auto& cell : cells) {
+            pairs.insert(pairs.end(), cell.pairs.begin(), cell.pairs.end());
+        }
+        std::sort(pairs.begin(), pairs.end());
+        pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+        intersection.insert(intersection.end(), pairs.begin(), pairs.end());
+    }
+
+private:
+    void checkCell(Cell& cell)
+    {
+        const MeshFacetArray& rFaces = mesh.GetFacets();
+        const std::vector<unsigned long>& elements = cell.facets;
         Base::Vector3f pt1, pt2;
-        for (std::vector<unsigned long>::iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
+        for (std::vector<unsigned long>::const_iterator it = elements.begin(); it != elements.end(); ++it) {
+            if (stopAtFirst && found)
+                return;
             const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
             const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<unsigned long>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) // the identical facet
-                    continue;
-                // If the facets share a common vertex we do not check for self-intersections because they 
+            MeshGeomFacet facet1 = mesh.GetFacet(rface1);
+            for (std::vector<unsigned long>::const_iterator jt = it + 1; jt != elements.end(); ++jt) {
+                // If the facets share a common vertex we do not check for self-intersections because they
                 // could but usually do not intersect each other and the algorithm below would detect false-positives,
                 // otherwise
                 const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0] || 
+                if (rface1._aulPoints[0] == rface2._aulPoints[0] ||
                     rface1._aulPoints[0] == rface2._aulPoints[1] ||
                     rface1._aulPoints[0] == rface2._aulPoints[2])
                     continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[1] == rface2._aulPoints[0] || 
+                if (rface1._aulPoints[1] == rface2._aulPoints[0] ||
                     rface1._aulPoints[1] == rface2._aulPoints[1] ||
                     rface1._aulPoints[1] == rface2._aulPoints[2])
                     continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[2] == rface2._aulPoints[0] || 
+                if (rface1._aulPoints[2] == rface2._aulPoints[0] ||
                     rface1._aulPoints[2] == rface2._aulPoints[1] ||
                     rface1._aulPoints[2] == rface2._aulPoints[2])
                     continue; // ignore facets sharing a common vertex
 
                 const Base::BoundBox3f& box2 = boxes[*jt];
                 if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
+                    MeshGeomFacet facet2 = mesh.GetFacet(rface2);
                     int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
                     if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
+                        cell.pairs.emplace_back(std::min(*it, *jt), std::max(*it, *jt));
+                        if (stopAtFirst) {
+                            found = true;
+                            return;
+                        }
                     }
                 }
             }
         }
     }
 
-    return true;
+private:
+    const MeshKernel& mesh;
+    bool stopAtFirst;
+    std::atomic<bool> found;
+    std::vector<Base::BoundBox3f> boxes;
+};
+
+}
+}
+
+bool MeshEvalSelfIntersection::Evaluate ()
+{
+    // abort after the first detected self-intersection
+    std::vector<std::pair<unsigned long, unsigned long> > intersection;
+    SelfIntersectionCheck check(_rclMesh, true);
+    check.Compute(intersection, false);
+    return intersection.empty();
 }
 
 void MeshEvalSelfIntersection::GetIntersections(const std::vector<std::pair<unsigned long, unsigned long> >& indices,
@@ -691,72 +756,8 @@ void MeshEvalSelfIntersection::GetIntersections(const std::vector<std::pair<unsi
 
 void MeshEvalSelfIntersection::GetIntersections(std::vector<std::pair<unsigned long, unsigned long> >& intersection) const
 {
-    // Contains bounding boxes for every facet 
-    std::vector<Base::BoundBox3f> boxes;
-    //intersection.clear();
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX, ulGridY, ulGridZ;
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for(cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX*ulGridY*ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        //Get the facet indices, belonging to the current grid unit
-        std::vector<unsigned long> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next(true);
-        if (aulGridElements.size()==0)
-            continue;
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (std::vector<unsigned long>::iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<unsigned long>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) // the identical facet
-                    continue;
-                // If the facets share a common vertex we do not check for self-intersections because they 
-                // could but usually do not intersect each other and the algorithm below would detect false-positives,
-                // otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[0] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[0] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[1] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[1] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[1] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[2] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[2] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[2] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        intersection.emplace_back (*it,*jt);
-                    }
-                }
-            }
-        }
-    }
+    SelfIntersectionCheck check(_rclMesh, false);
+    check.Compute(intersection, true);
 }
 
 std::vector<unsigned long> MeshFixSelfIntersection::GetFacets() const
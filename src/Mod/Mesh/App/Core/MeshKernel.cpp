@@ -840,18 +840,33 @@ void MeshKernel::Write (std::ostream &rclOut) const
     // write the number of points and facets
     str << static_cast<uint32_t>(CountPoints()) << static_cast<uint32_t>(CountFacets());
 
-    // write the data
-    for (MeshPointArray::_TConstIterator it = _aclPointArray.begin(); it != _aclPointArray.end(); ++it) {
-        str << it->x << it->y << it->z;
+    // write the data in blocks to avoid a stream call per value
+    const std::size_t blockSize = 4096;
+    std::vector<float> coords;
+    coords.reserve(3*blockSize);
+    for (MeshPointArray::_TConstIterator it = _aclPointArray.begin(); it != _aclPointArray.end();) {
+        coords.clear();
+        for (std::size_t i=0; i<blockSize && it != _aclPointArray.end(); ++i, ++it) {
+            coords.push_back(it->x);
+            coords.push_back(it->y);
+            coords.push_back(it->z);
+        }
+        str.write(coords.data(), coords.size());
     }
 
-    for (MeshFacetArray::_TConstIterator it = _aclFacetArray.begin(); it != _aclFacetArray.end(); ++it) {
-        str << static_cast<uint32_t>(it->_aulPoints[0])
-            << static_cast<uint32_t>(it->_aulPoints[1])
-            << static_cast<uint32_t>(it->_aulPoints[2]);
-        str << static_cast<uint32_t>(it->_aulNeighbours[0])
-            << static_cast<uint32_t>(it->_aulNeighbours[1])
-            << static_cast<uint32_t>(it->_aulNeighbours[2]);
+    std::vector<uint32_t> indices;
+    indices.reserve(6*blockSize);
+    for (MeshFacetArray::_TConstIterator it = _aclFacetArray.begin(); it != _aclFacetArray.end();) {
+        indices.clear();
+        for (std::size_t i=0; i<blockSize && it != _aclFacetArray.end(); ++i, ++it) {
+            indices.push_back(static_cast<uint32_t>(it->_aulPoints[0]));
+            indices.push_back(static_cast<uint32_t>(it->_aulPoints[1]));
+            indices.push_back(static_cast<uint32_t>(it->_aulPoints[2]));
+            indices.push_back(static_cast<uint32_t>(it->_aulNeighbours[0]));
+            indices.push_back(static_cast<uint32_t>(it->_aulNeighbours[1]));
+            indices.push_back(static_cast<uint32_t>(it->_aulNeighbours[2]));
+        }
+        str.write(indices.data(), indices.size());
     }
 
     str << _clBoundBox.MinX << _clBoundBox.MaxX;
@@ -893,19 +908,35 @@ void MeshKernel::Read (std::istream &rclIn)
         str >> uCtPts >> uCtFts;
 
         try {
-            // read the data
+            // read the data in blocks to avoid a stream call per value
+            const std::size_t blockSize = 4096;
             MeshPointArray pointArray;
             pointArray.resize(uCtPts);
-            for (MeshPointArray::_TIterator it = pointArray.begin(); it != pointArray.end(); ++it) {
-                str >> it->x >> it->y >> it->z;
+            std::vector<float> coords(3*blockSize);
+            for (MeshPointArray::_TIterator it = pointArray.begin(); it != pointArray.end();) {
+                std::size_t count = std::min<std::size_t>(blockSize, pointArray.end() - it);
+                str.read(coords.data(), 3*count);
+                for (std::size_t i=0; i<count; ++i, ++it) {
+                    it->Set(coords[3*i], coords[3*i+1], coords[3*i+2]);
+                }
             }
           
             MeshFacetArray facetArray;
             facetArray.resize(uCtFts);
 
             uint32_t v1, v2, v3;
+            std::vector<uint32_t> indices(6*blockSize);
+            std::size_t index = indices.size();
             for (MeshFacetArray::_TIterator it = facetArray.begin(); it != facetArray.end(); ++it) {
-                str >> v1 >> v2 >> v3;
+                if (index == indices.size()) {
+                    std::size_t count = std::min<std::size_t>(blockSize, facetArray.end() - it);
+                    str.read(indices.data(), 6*count);
+                    index = 0;
+                }
+
+                v1 = indices[index++];
+                v2 = indices[index++];
+                v3 = indices[index++];
 
                 // make sure to have valid indices
                 if (v1 >= uCtPts || v2 >= uCtPts || v3 >= uCtPts)
@@ -919,7 +950,9 @@ void MeshKernel::Read (std::istream &rclIn)
                 // the empty neighbour must be explicitly set to 'ULONG_MAX'
                 // because in algorithms this value is always used to check
                 // for open edges.
-                str >> v1 >> v2 >> v3;
+                v1 = indices[index++];
+                v2 = indices[index++];
+                v3 = indices[index++];
 
                 // make sure to have valid indices
                 if (v1 >= uCtFts && v1 < open_edge)
@@ -29,6 +29,8 @@
 #include "Algorithm.h"
 #include "Approximation.h"
 
+#include <QtConcurrentMap>
+
 using namespace MeshCore;
 
 void MeshSurfaceSegment::Initialize(unsigned long)
@@ -64,7 +66,7 @@ MeshSegment MeshSurfaceSegment::FindSegment(unsigned long index) const
 // --------------------------------------------------------
 
 MeshDistancePlanarSegment::MeshDistancePlanarSegment(const MeshKernel& mesh, unsigned long minFacets, float tol)
-  : MeshDistanceSurfaceSegment(mesh, minFacets, tol), fitter(new PlaneFit)
+  : MeshDistanceSurfaceSegment(mesh, minFacets, tol), fitter(new IncrementalPlaneFit)
 {
 }
 
@@ -107,7 +109,7 @@ void MeshDistancePlanarSegment::AddFacet(const MeshFacet& face)
 // --------------------------------------------------------
 
 PlaneSurfaceFit::PlaneSurfaceFit()
-    : fitter(new PlaneFit)
+    : fitter(new IncrementalPlaneFit)
 {
 }
 
@@ -523,6 +525,10 @@ MeshSurfaceVisitor::~MeshSurfaceVisitor ()
 bool MeshSurfaceVisitor::AllowVisit (const MeshFacet& face, const MeshFacet&, 
                                      unsigned long, unsigned long, unsigned short)
 {
+    // an already visited facet is skipped anyway, so don't test it and
+    // especially don't trigger a refit of the surface
+    if (face.IsFlag(MeshFacet::VISIT))
+        return false;
     return segm.TestFacet(face);
 }
 
@@ -536,6 +542,43 @@ bool MeshSurfaceVisitor::Visit (const MeshFacet & face, const MeshFacet &,
 
 // --------------------------------------------------------
 
+namespace {
+// Visitor for segments with a static facet test whose results are computed in advance
+class MeshStaticSurfaceVisitor : public MeshSurfaceVisitor
+{
+public:
+    MeshStaticSurfaceVisitor(MeshSurfaceSegment& segm, std::vector<unsigned long>& indices,
+                             const std::vector<char>& accepted)
+        : MeshSurfaceVisitor(segm, indices), accepted(accepted)
+    {
+    }
+    bool AllowVisit (const MeshFacet& face, const MeshFacet&,
+                     unsigned long ulFInd, unsigned long, unsigned short)
+    {
+        return accepted[ulFInd] != 0 && !face.IsFlag(MeshFacet::VISIT);
+    }
+
+private:
+    const std::vector<char>& accepted;
+};
+
+// Tests all facets in parallel
+void testFacets(const MeshSurfaceSegment& segm, const MeshFacetArray& rFAry, std::vector<char>& accepted)
+{
+    const std::size_t blockSize = 4096;
+    std::size_t count = rFAry.size();
+    std::vector<std::pair<std::size_t, std::size_t> > blocks;
+    for (std::size_t i=0; i<count; i+=blockSize)
+        blocks.emplace_back(i, std::min(i + blockSize, count));
+
+    accepted.resize(count);
+    QtConcurrent::blockingMap(blocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+        for (std::size_t i=block.first; i<block.second; i++)
+            accepted[i] = segm.TestFacet(rFAry[i]) ? 1 : 0;
+    });
+}
+}
+
 void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm)
 {
     // reset VISIT flags
@@ -556,6 +599,11 @@ void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm
         cAlgo.ResetFacetsFlag(resetVisited, MeshCore::MeshFacet::VISIT);
         resetVisited.clear();
 
+        // a static facet test is done only once for each facet
+        std::vector<char> accepted;
+        if ((*it)->IsStaticTest())
+            testFacets(**it, rFAry, accepted);
+
         MeshCore::MeshIsNotFlag<MeshCore::MeshFacet> flag;
         iCur = std::find_if(iBeg, iEnd, [flag](const MeshFacet& f) {
             return flag(f, MeshFacet::VISIT);
@@ -570,8 +618,14 @@ void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm
             (*it)->Initialize(startFacet);
             if ((*it)->TestInitialFacet(startFacet))
                 indices.push_back(startFacet);
-            MeshSurfaceVisitor pv(**it, indices);
-            myKernel.VisitNeighbourFacets(pv, startFacet);
+            if (accepted.empty()) {
+                MeshSurfaceVisitor pv(**it, indices);
+                myKernel.VisitNeighbourFacets(pv, startFacet);
+            }
+            else {
+                MeshStaticSurfaceVisitor pv(**it, indices, accepted);
+                myKernel.VisitNeighbourFacets(pv, startFacet);
+            }
 
             // add or discard the segment
             if (indices.size() <= 1) {
@@ -31,7 +31,7 @@
 
 namespace MeshCore {
 
-class PlaneFit;
+class IncrementalPlaneFit;
 class CylinderFit;
 class SphereFit;
 class MeshFacet;
@@ -47,6 +47,9 @@ public:
     virtual const char* GetType() const = 0;
     virtual void Initialize(unsigned long);
     virtual bool TestInitialFacet(unsigned long) const;
+    /// Returns true if TestFacet() only depends on the passed facet but not on the
+    /// facets added so far. Such a test can be done for all facets in advance.
+    virtual bool IsStaticTest() const { return false; }
     virtual void AddFacet(const MeshFacet& rclFacet);
     void AddSegment(const std::vector<unsigned long>&);
     const std::vector<MeshSegment>& GetSegments() const { return segments; }
@@ -84,7 +87,7 @@ public:
 protected:
     Base::Vector3f basepoint;
     Base::Vector3f normal;
-    PlaneFit* fitter;
+    IncrementalPlaneFit* fitter;
 };
 
 class MeshExport AbstractSurfaceFit
@@ -120,7 +123,7 @@ public:
 private:
     Base::Vector3f basepoint;
     Base::Vector3f normal;
-    PlaneFit* fitter;
+    IncrementalPlaneFit* fitter;
 };
 
 class MeshExport CylinderSurfaceFit : public AbstractSurfaceFit
@@ -190,6 +193,7 @@ class MeshExport MeshCurvatureSurfaceSegment : public MeshSurfaceSegment
 public:
     MeshCurvatureSurfaceSegment(const std::vector<CurvatureInfo>& ci, unsigned long minFacets)
         : MeshSurfaceSegment(minFacets), info(ci) {}
+    bool IsStaticTest() const { return true; }
 
 protected:
     const std::vector<CurvatureInfo>& info;
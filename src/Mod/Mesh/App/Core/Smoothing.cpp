@@ -23,6 +23,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
 #endif
 
 #include "Smoothing.h"
@@ -32,6 +33,8 @@
 #include "Iterator.h"
 #include "Approximation.h"
 
+#include <QtConcurrentMap>
+
 
 using namespace MeshCore;
 
@@ -78,11 +81,11 @@ void PlaneFitSmoothing::Smooth(unsigned int iterations)
             MeshCore::PlaneFit pf;
             pf.AddPoint(*v_it);
             center = *v_it;
-            const std::set<unsigned long>& cv = vv_it[v_it.Position()];
+            MeshCore::MeshIndexRange cv = vv_it[v_it.Position()];
             if (cv.size() < 3)
                 continue;
 
-            std::set<unsigned long>::const_iterator cv_it;
+            MeshCore::MeshIndexRange::const_iterator cv_it;
             for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
                 pf.AddPoint(v_beg[*cv_it]);
                 center += v_beg[*cv_it];
@@ -132,11 +135,11 @@ void PlaneFitSmoothing::SmoothPoints(unsigned int iterations, const std::vector<
             MeshCore::PlaneFit pf;
             pf.AddPoint(*v_it);
             center = *v_it;
-            const std::set<unsigned long>& cv = vv_it[v_it.Position()];
+            MeshCore::MeshIndexRange cv = vv_it[v_it.Position()];
             if (cv.size() < 3)
                 continue;
 
-            std::set<unsigned long>::const_iterator cv_it;
+            MeshCore::MeshIndexRange::const_iterator cv_it;
             for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
                 pf.AddPoint(v_beg[*cv_it]);
                 center += v_beg[*cv_it];
@@ -179,94 +182,131 @@ LaplaceSmoothing::~LaplaceSmoothing()
 {
 }
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it, double stepsize)
+void LaplaceSmoothing::BuildNeighbours(MeshIndexTable& nb) const
 {
     const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_it,
-    v_beg = points.begin(), v_end = points.end();
-
-    unsigned long pos = 0;
-    for (v_it = points.begin(); v_it != v_end; ++v_it,++pos) {
-        const std::set<unsigned long>& cv = vv_it[pos];
-        if (cv.size() < 3)
-            continue;
-        if (cv.size() != vf_it[pos].size()) {
-            // do nothing for border points
-            continue;
-        }
-
-        size_t n_count = cv.size();
-        double w;
-        w=1.0/double(n_count);
+    const MeshCore::MeshFacetArray& facets = kernel.GetFacets();
+    std::size_t numPoints = points.size();
+
+    // each facet adds the two other corners as neighbours of a point
+    std::vector<unsigned long> numFacets(numPoints, 0);
+    for (MeshFacetArray::_TConstIterator it = facets.begin(); it != facets.end(); ++it) {
+        for (int i=0; i<3; i++)
+            numFacets[it->_aulPoints[i]]++;
+    }
 
-        double delx=0.0,dely=0.0,delz=0.0;
-        std::set<unsigned long>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-            delx += w*static_cast<double>((v_beg[*cv_it]).x-v_it->x);
-            dely += w*static_cast<double>((v_beg[*cv_it]).y-v_it->y);
-            delz += w*static_cast<double>((v_beg[*cv_it]).z-v_it->z);
+    std::vector<unsigned long> offsets(numPoints + 1);
+    offsets[0] = 0;
+    for (std::size_t i=0; i<numPoints; i++)
+        offsets[i+1] = offsets[i] + 2*numFacets[i];
+
+    std::vector<unsigned long> indices(offsets[numPoints]);
+    std::vector<unsigned long> fill(offsets.begin(), offsets.end()-1);
+    for (MeshFacetArray::_TConstIterator it = facets.begin(); it != facets.end(); ++it) {
+        for (int i=0; i<3; i++) {
+            unsigned long pos = it->_aulPoints[i];
+            indices[fill[pos]++] = it->_aulPoints[(i+1)%3];
+            indices[fill[pos]++] = it->_aulPoints[(i+2)%3];
         }
+    }
 
-        float x = static_cast<float>(static_cast<double>(v_it->x)+stepsize*delx);
-        float y = static_cast<float>(static_cast<double>(v_it->y)+stepsize*dely);
-        float z = static_cast<float>(static_cast<double>(v_it->z)+stepsize*delz);
-        kernel.SetPoint(pos,x,y,z);
+    // remove duplicates and compact the ranges in place
+    unsigned long* data = indices.data();
+    unsigned long begin = 0, dst = 0;
+    for (std::size_t i=0; i<numPoints; i++) {
+        unsigned long end = begin + 2*numFacets[i];
+        std::sort(data + begin, data + end);
+        unsigned long count = std::unique(data + begin, data + end) - (data + begin);
+        offsets[i] = dst;
+        // do nothing for border points
+        if (count >= 3 && count == numFacets[i]) {
+            std::copy(data + begin, data + begin + count, data + dst);
+            dst += count;
+        }
+        begin = end;
     }
+
+    offsets[numPoints] = dst;
+    indices.resize(dst);
+    indices.shrink_to_fit();
+    nb.Assign(offsets, indices);
 }
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it, double stepsize,
-                                const std::vector<unsigned long>& point_indices)
+namespace {
+// Computes the new positions of the points in parallel from the old positions
+// (Jacobi style) and assigns them afterwards
+template <typename PointIndex>
+void umbrellaStep(MeshKernel& kernel, const MeshIndexTable& nb, double stepsize,
+                  std::size_t count, PointIndex pointIndex)
 {
     const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
-
-    for (std::vector<unsigned long>::const_iterator pos = point_indices.begin(); pos != point_indices.end(); ++pos) {
-        const std::set<unsigned long>& cv = vv_it[*pos];
-        if (cv.size() < 3)
-            continue;
-        if (cv.size() != vf_it[*pos].size()) {
-            // do nothing for border points
-            continue;
-        }
+    std::vector<Base::Vector3f> newPoints(count);
+
+    const std::size_t blockSize = 4096;
+    std::vector<std::pair<std::size_t, std::size_t> > blocks;
+    for (std::size_t i=0; i<count; i+=blockSize)
+        blocks.emplace_back(i, std::min(i + blockSize, count));
+
+    QtConcurrent::blockingMap(blocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+        for (std::size_t i=block.first; i<block.second; i++) {
+            unsigned long pos = pointIndex(i);
+            const Base::Vector3f& pnt = points[pos];
+            newPoints[i] = pnt;
 
-        size_t n_count = cv.size();
-        double w;
-        w=1.0/double(n_count);
+            MeshIndexRange range = nb[pos];
+            if (range.empty())
+                continue;
+
+            double w = 1.0/double(range.size());
+            double delx=0.0,dely=0.0,delz=0.0;
+            for (MeshIndexRange::const_iterator it = range.begin(); it != range.end(); ++it) {
+                const Base::Vector3f& nbr = points[*it];
+                delx += static_cast<double>(nbr.x-pnt.x);
+                dely += static_cast<double>(nbr.y-pnt.y);
+                delz += static_cast<double>(nbr.z-pnt.z);
+            }
 
-        double delx=0.0,dely=0.0,delz=0.0;
-        std::set<unsigned long>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-            delx += w*static_cast<double>((v_beg[*cv_it]).x-(v_beg[*pos]).x);
-            dely += w*static_cast<double>((v_beg[*cv_it]).y-(v_beg[*pos]).y);
-            delz += w*static_cast<double>((v_beg[*cv_it]).z-(v_beg[*pos]).z);
+            newPoints[i].x = static_cast<float>(static_cast<double>(pnt.x)+stepsize*w*delx);
+            newPoints[i].y = static_cast<float>(static_cast<double>(pnt.y)+stepsize*w*dely);
+            newPoints[i].z = static_cast<float>(static_cast<double>(pnt.z)+stepsize*w*delz);
         }
+    });
 
-        float x = static_cast<float>(static_cast<double>((v_beg[*pos]).x)+stepsize*delx);
-        float y = static_cast<float>(static_cast<double>((v_beg[*pos]).y)+stepsize*dely);
-        float z = static_cast<float>(static_cast<double>((v_beg[*pos]).z)+stepsize*delz);
-        kernel.SetPoint(*pos,x,y,z);
-    }
+    for (std::size_t i=0; i<count; i++)
+        kernel.SetPoint(pointIndex(i), newPoints[i]);
+}
+}
+
+void LaplaceSmoothing::Umbrella(const MeshIndexTable& nb, double stepsize)
+{
+    umbrellaStep(kernel, nb, stepsize, kernel.CountPoints(),
+                 [](std::size_t i) { return static_cast<unsigned long>(i); });
+}
+
+void LaplaceSmoothing::Umbrella(const MeshIndexTable& nb, double stepsize,
+                                const std::vector<unsigned long>& point_indices)
+{
+    umbrellaStep(kernel, nb, stepsize, point_indices.size(),
+                 [&point_indices](std::size_t i) { return point_indices[i]; });
 }
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshIndexTable nb;
+    BuildNeighbours(nb);
 
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
+        Umbrella(nb, lambda);
     }
 }
 
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations, const std::vector<unsigned long>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshIndexTable nb;
+    BuildNeighbours(nb);
 
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
+        Umbrella(nb, lambda, point_indices);
     }
 }
 
@@ -281,26 +321,26 @@ TaubinSmoothing::~TaubinSmoothing()
 
 void TaubinSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshIndexTable nb;
+    BuildNeighbours(nb);
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations+1)/2; // two steps per iteration
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
-        Umbrella(vv_it, vf_it, -(lambda+micro));
+        Umbrella(nb, lambda);
+        Umbrella(nb, -(lambda+micro));
     }
 }
 
 void TaubinSmoothing::SmoothPoints(unsigned int iterations, const std::vector<unsigned long>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshIndexTable nb;
+    BuildNeighbours(nb);
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations+1)/2; // two steps per iteration
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
-        Umbrella(vv_it, vf_it, -(lambda+micro), point_indices);
+        Umbrella(nb, lambda, point_indices);
+        Umbrella(nb, -(lambda+micro), point_indices);
     }
 }
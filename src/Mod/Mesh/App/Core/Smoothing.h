@@ -31,6 +31,7 @@ namespace MeshCore
 class MeshKernel;
 class MeshRefPointToPoints;
 class MeshRefPointToFacets;
+class MeshIndexTable;
 
 /** Base class for smoothing algorithms. */
 class MeshExport AbstractSmoothing
@@ -83,10 +84,12 @@ public:
     void SetLambda(double l) { lambda = l;}
 
 protected:
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&, double);
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&, double,
+    /** Builds the neighbour points of each point. Border points and points
+     * with less than three neighbours get an empty range.
+     */
+    void BuildNeighbours(MeshIndexTable&) const;
+    void Umbrella(const MeshIndexTable&, double);
+    void Umbrella(const MeshIndexTable&, double,
                   const std::vector<unsigned long>&);
 
 protected:
@@ -997,16 +997,22 @@ void MeshObject::smooth(int iterations, float d_max)
     _kernel.Smooth(iterations, d_max);
 }
 
-void MeshObject::decimate(float fTolerance, float fReduction)
+float MeshObject::decimate(float fTolerance, float fReduction, bool parallel, bool measure)
 {
     MeshCore::MeshSimplify dm(this->_kernel);
+    dm.setParallel(parallel);
+    dm.setMeasureError(measure);
     dm.simplify(fTolerance, fReduction);
+    return dm.getHausdorffDistance();
 }
 
-void MeshObject::decimate(int targetSize)
+float MeshObject::decimate(int targetSize, bool parallel, bool measure)
 {
     MeshCore::MeshSimplify dm(this->_kernel);
+    dm.setParallel(parallel);
+    dm.setMeasureError(measure);
     dm.simplify(targetSize);
+    return dm.getHausdorffDistance();
 }
 
 Base::Vector3d MeshObject::getPointNormal(unsigned long index) const
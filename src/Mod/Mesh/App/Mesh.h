@@ -218,8 +218,12 @@ public:
     void movePoint(unsigned long, const Base::Vector3d& v);
     void setPoint(unsigned long, const Base::Vector3d& v);
     void smooth(int iterations, float d_max);
-    void decimate(float fTolerance, float fReduction);
-    void decimate(int targetSize);
+    /** Decimate the mesh. With \a parallel large meshes are decimated in
+     * concurrently simplified parts. Returns the one-sided Hausdorff distance
+     * of the input to the result if \a measure is true, otherwise -1.
+     */
+    float decimate(float fTolerance, float fReduction, bool parallel=false, bool measure=false);
+    float decimate(int targetSize, bool parallel=false, bool measure=false);
     Base::Vector3d getPointNormal(unsigned long) const;
     std::vector<Base::Vector3d> getPointNormals() const;
     void crossSections(const std::vector<TPlane>&, std::vector<TPolylines> &sections,
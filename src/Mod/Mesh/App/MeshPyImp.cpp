@@ -1807,26 +1807,43 @@ PyObject*  MeshPy::smooth(PyObject *args, PyObject *kwds)
 
 PyObject*  MeshPy::decimate(PyObject *args)
 {
-    float fTol, fRed;
-    if (PyArg_ParseTuple(args, "ff", &fTol,&fRed)) {
+    // The target size is parsed first, otherwise a boolean would be taken
+    // as the reduction factor
+    int targetSize;
+    PyObject* parallel = Py_False;
+    PyObject* measure = Py_False;
+    if (PyArg_ParseTuple(args, "i|O!O!", &targetSize, &PyBool_Type, &parallel, &PyBool_Type, &measure)) {
+        float error = -1.0f;
         PY_TRY {
-            getMeshObjectPtr()->decimate(fTol, fRed);
+            error = getMeshObjectPtr()->decimate(targetSize,
+                PyObject_IsTrue(parallel) ? true : false,
+                PyObject_IsTrue(measure) ? true : false);
         } PY_CATCH;
 
+        if (PyObject_IsTrue(measure))
+            return PyFloat_FromDouble(error);
         Py_Return;
     }
 
     PyErr_Clear();
-    int targetSize;
-    if (PyArg_ParseTuple(args, "i", &targetSize)) {
+    float fTol, fRed;
+    parallel = Py_False;
+    measure = Py_False;
+    if (PyArg_ParseTuple(args, "ff|O!O!", &fTol,&fRed, &PyBool_Type, &parallel, &PyBool_Type, &measure)) {
+        float error = -1.0f;
         PY_TRY {
-            getMeshObjectPtr()->decimate(targetSize);
+            error = getMeshObjectPtr()->decimate(fTol, fRed,
+                PyObject_IsTrue(parallel) ? true : false,
+                PyObject_IsTrue(measure) ? true : false);
         } PY_CATCH;
 
+        if (PyObject_IsTrue(measure))
+            return PyFloat_FromDouble(error);
         Py_Return;
     }
 
-    PyErr_SetString(PyExc_ValueError, "decimate(tolerance=float, reduction=float) or decimate(targetSize=int)");
+    PyErr_SetString(PyExc_ValueError, "decimate(tolerance=float, reduction=float, [parallel=bool, measure=bool]) "
+                                      "or decimate(targetSize=int, [parallel=bool, measure=bool])");
     return nullptr;
 }
 
@@ -170,9 +170,13 @@
 # include <TopTools_DataMapIteratorOfDataMapOfShapeListOfShape.hxx>
 # include <GeomFill_FillingStyle.hxx>
 # include <GeomFill_BSplineCurves.hxx>
+# include <TopTools_DataMapOfShapeInteger.hxx>
+# include <OSD_Parallel.hxx>
 
 #include <array>
+#include <atomic>
 #include <deque>
+#include <mutex>
 #include <boost/algorithm/string/predicate.hpp>
 #include <Base/Exception.h>
 #include <Base/Console.h>
@@ -191,6 +195,7 @@
 #include "BRepOffsetAPI_MakeOffsetFix.h"
 #include "Geometry.h"
 #include "FaceMakerBullseye.h"
+#include "PartParams.h"
 
 #define TOPOP_VERSION 15
 
@@ -308,39 +313,252 @@ struct ShapeRelationKey {
     }
 };
 
+// Topology index of a shape built in a single traversal. Sub-shapes are
+// indexed per type in the same order as TopExp::MapShapes(), and the direct
+// children of each indexed sub-shape are stored in one flat table, from which
+// the ancestor tables are derived on demand. The index is immutable once
+// built, except for the ancestor tables which are guarded by a mutex, so it
+// can be queried by concurrent readers. Indices of frozen shapes (i.e. shapes
+// that have been added to some other shape, and thus can no longer be edited)
+// are shared by all caches of the same TopoDS_TShape.
+class ShapeTopology {
+public:
+    typedef std::shared_ptr<ShapeTopology> Ptr;
+
+    static Ptr get(const TopoDS_Shape &shape);
+
+    const TopTools_IndexedMapOfShape &shapes(TopAbs_ShapeEnum type) const {
+        return maps[type];
+    }
+
+    /** Return the ancestor indices of type \c ancestorType of the sub-shape
+     * of type \c type at \c index, sorted by the ancestor index.
+     */
+    const int *findAncestors(TopAbs_ShapeEnum type, int index,
+                             TopAbs_ShapeEnum ancestorType, int &count);
+
+private:
+    explicit ShapeTopology(const TopoDS_Shape &shape);
+
+    void visit(const TopoDS_Shape &shape, bool nested, std::vector<int> &pending);
+
+    static int encode(TopAbs_ShapeEnum type, int index) {
+        return (index << 3) | (int)type;
+    }
+    static TopAbs_ShapeEnum nodeType(int node) {
+        return (TopAbs_ShapeEnum)(node & 7);
+    }
+    static int nodeIndex(int node) {
+        return node >> 3;
+    }
+
+private:
+    TopoDS_Shape shape;
+
+    // Indexed sub-shapes per type. The last entry holds the direct children
+    // of the shape, same as the old TopAbs_SHAPE cache.
+    std::array<TopTools_IndexedMapOfShape, TopAbs_SHAPE+1> maps;
+
+    // Direct children of each indexed sub-shape, stored as (offset, count)
+    // into 'children', with nested compounds expanded.
+    std::array<std::vector<std::pair<int,int> >, TopAbs_SHAPE> ranges;
+    std::vector<int> children;
+
+    struct Ancestors {
+        std::atomic<bool> inited{false};
+        // Ancestors of sub-shape i (one based) are stored in
+        // indices[offsets[i-1], offsets[i])
+        std::vector<int> offsets;
+        std::vector<int> indices;
+    };
+    std::array<std::array<Ancestors, TopAbs_SHAPE>, TopAbs_SHAPE> ancestors;
+    std::mutex mutex;
+};
+
+ShapeTopology::ShapeTopology(const TopoDS_Shape &s)
+    :shape(s)
+{
+    if(shape.IsNull())
+        return;
+    std::vector<int> pending;
+    visit(shape, false, pending);
+    for(TopoDS_Iterator it(shape);it.More();it.Next())
+        maps[TopAbs_SHAPE].Add(it.Value());
+}
+
+void ShapeTopology::visit(const TopoDS_Shape &s, bool nested, std::vector<int> &pending)
+{
+    auto type = s.ShapeType();
+    if(nested && type == TopAbs_COMPOUND) {
+        // TopExp_Explorer does not report compounds nested inside another
+        // compound, so expand their children into the enclosing shape.
+        for(TopoDS_Iterator it(s);it.More();it.Next())
+            visit(it.Value(), true, pending);
+        return;
+    }
+
+    auto &map = maps[type];
+    int count = map.Extent();
+    int index = map.Add(s);
+    pending.push_back(encode(type, index));
+    if(index <= count)
+        return;
+
+    // Children are visited depth first in order, so that the sub-shapes are
+    // indexed in the same order as TopExp_Explorer.
+    std::size_t mark = pending.size();
+    for(TopoDS_Iterator it(s);it.More();it.Next())
+        visit(it.Value(), nested || type == TopAbs_COMPOUND, pending);
+
+    auto &range = ranges[type];
+    if((int)range.size() < index)
+        range.resize(index);
+    range[index-1] = std::make_pair((int)children.size(), (int)(pending.size()-mark));
+    children.insert(children.end(), pending.begin()+mark, pending.end());
+    pending.resize(mark);
+}
+
+const int *ShapeTopology::findAncestors(TopAbs_ShapeEnum type, int index,
+                                        TopAbs_ShapeEnum ancestorType, int &count)
+{
+    count = 0;
+    if(type >= TopAbs_SHAPE || ancestorType >= TopAbs_SHAPE
+            || index <= 0 || index > maps[type].Extent())
+        return nullptr;
+
+    auto &info = ancestors[type][ancestorType];
+    if(!info.inited.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!info.inited.load(std::memory_order_relaxed)) {
+            std::vector<std::pair<int,int> > pairs;
+            if(ancestorType <= type) {
+                // Walk down the children table from each ancestor, and
+                // stamp the visited sub-shapes with the ancestor index to
+                // skip the shared ones.
+                std::array<std::vector<int>, TopAbs_SHAPE> stamps;
+                for(int t=ancestorType; t<=type; ++t)
+                    stamps[t].assign(maps[t].Extent(), 0);
+                std::vector<int> stack;
+                for(int i=1, c=maps[ancestorType].Extent(); i<=c; ++i) {
+                    stack.push_back(encode(ancestorType, i));
+                    while(stack.size()) {
+                        int node = stack.back();
+                        stack.pop_back();
+                        auto t = nodeType(node);
+                        int idx = nodeIndex(node);
+                        auto &stamp = stamps[t][idx-1];
+                        if(stamp == i)
+                            continue;
+                        stamp = i;
+                        if(t == type) {
+                            pairs.emplace_back(idx, i);
+                            continue;
+                        }
+                        const auto &range = ranges[t][idx-1];
+                        for(int k=range.first+range.second-1; k>=range.first; --k) {
+                            int child = children[k];
+                            if(nodeType(child) <= type)
+                                stack.push_back(child);
+                        }
+                    }
+                }
+            }
+            int n = maps[type].Extent();
+            info.offsets.assign(n+1, 0);
+            for(auto &v : pairs)
+                ++info.offsets[v.first];
+            for(int i=1; i<=n; ++i)
+                info.offsets[i] += info.offsets[i-1];
+            info.indices.resize(pairs.size());
+            std::vector<int> pos(info.offsets.begin(), info.offsets.end()-1);
+            // The pairs are generated in ancestor order, so the ancestors of
+            // each sub-shape end up sorted.
+            for(auto &v : pairs)
+                info.indices[pos[v.first-1]++] = v.second;
+            info.inited.store(true, std::memory_order_release);
+        }
+    }
+    count = info.offsets[index] - info.offsets[index-1];
+    return count ? &info.indices[info.offsets[index-1]] : nullptr;
+}
+
+ShapeTopology::Ptr ShapeTopology::get(const TopoDS_Shape &shape)
+{
+    // Free shapes may still be modified by BRep_Builder, so don't share
+    // their index.
+    if(shape.IsNull() || shape.Free())
+        return Ptr(new ShapeTopology(shape));
+
+    typedef std::pair<const Standard_Transient*, int> Key;
+    static std::mutex registryMutex;
+    static std::map<Key, std::weak_ptr<ShapeTopology> > registry;
+    static std::size_t sweepSize = 1024;
+
+    Key key(shape.TShape().operator->(), (int)shape.Orientation());
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto it = registry.find(key);
+        if(it != registry.end()) {
+            auto res = it->second.lock();
+            if(res)
+                return res;
+        }
+    }
+
+    // Build outside of the lock. The index holds a reference of the
+    // TShape, so the key stays unique while the index is alive.
+    Ptr res(new ShapeTopology(shape));
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto &entry = registry[key];
+    auto existing = entry.lock();
+    if(existing)
+        return existing;
+    entry = res;
+    if(registry.size() > sweepSize) {
+        for(auto it=registry.begin(); it!=registry.end();) {
+            if(it->second.expired())
+                it = registry.erase(it);
+            else
+                ++it;
+        }
+        sweepSize = std::max<std::size_t>(1024, registry.size()*2);
+    }
+    return res;
+}
+
 class TopoShape::Cache {
 
 public:
     TopoDS_Shape shape;
     TopLoc_Location loc;
     TopLoc_Location locInv;
+    std::mutex locMutex;
 
     std::size_t memsize = 0;
 
-    struct AncestorInfo {
-        bool inited = false;
-        TopTools_IndexedDataMapOfShapeListOfShape shapes;
-    };
+    ShapeTopology::Ptr topology;
+    std::once_flag topologyFlag;
+
     class Info {
     private:
         Cache *owner = 0;
-        TopTools_IndexedMapOfShape shapes;
+        const TopTools_IndexedMapOfShape *shapes = 0;
         std::vector<TopoShape> topoShapes;
-        std::array<AncestorInfo, TopAbs_SHAPE+1> ancestors;
 
         TopoShape _getTopoShape(const TopoShape &parent, int index) {
             TopoShape res;
             auto &s = topoShapes[index-1];
             if(parent.getShape().Location().IsIdentity()) {
                 if(s.isNull()) {
-                    s._Shape = shapes.FindKey(index);
+                    s._Shape = shapes->FindKey(index);
                     s.Tag = parent.Tag;
                     s.mapSubElement(parent);
                 }
                 res = s;
             } else {
                 if(s.isNull()) {
-                    s._Shape = shapes.FindKey(index);
+                    s._Shape = shapes->FindKey(index);
                     auto copy = parent;
                     // Subshapes are cached without any parent transformation,
                     // so we have to strip out the parent shape transformation
@@ -362,14 +580,14 @@ public:
 
         TopoShape getTopoShape(const TopoShape &parent, int index) {
             TopoShape res;
-            if(index<=0 || index>shapes.Extent())
+            if(index<=0 || index>shapes->Extent())
                 return res;
-            topoShapes.resize(shapes.Extent());
+            topoShapes.resize(shapes->Extent());
             return _getTopoShape(parent,index);
         }
 
         std::vector<TopoShape> getTopoShapes(const TopoShape &parent) {
-            int count = shapes.Extent();
+            int count = shapes->Extent();
             std::vector<TopoShape> res;
             res.reserve(count);
             topoShapes.resize(count);
@@ -379,30 +597,35 @@ public:
         }
 
         TopoDS_Shape stripLocation(const TopoDS_Shape &parent, const TopoDS_Shape &child) {
-            if(parent.Location() != owner->loc) {
-                owner->loc = parent.Location();
-                owner->locInv = parent.Location().Inverted();
+            TopLoc_Location locInv;
+            {
+                std::lock_guard<std::mutex> lock(owner->locMutex);
+                if(parent.Location() != owner->loc) {
+                    owner->loc = parent.Location();
+                    owner->locInv = parent.Location().Inverted();
+                }
+                locInv = owner->locInv;
             }
-            return child.Located(owner->locInv*child.Location());
+            return child.Located(locInv*child.Location());
         }
 
         int find(const TopoDS_Shape &parent, const TopoDS_Shape &subshape) {
             if(parent.Location().IsIdentity())
-                return shapes.FindIndex(subshape);
-            return shapes.FindIndex(stripLocation(parent,subshape));
+                return shapes->FindIndex(subshape);
+            return shapes->FindIndex(stripLocation(parent,subshape));
         }
 
         TopoDS_Shape find(const TopoDS_Shape &parent, int index) {
-            if(index<=0 || index>shapes.Extent())
+            if(index<=0 || index>shapes->Extent())
                 return TopoDS_Shape();
             if(parent.Location().IsIdentity())
-                return shapes.FindKey(index);
+                return shapes->FindKey(index);
             else
-                return shapes.FindKey(index).Moved(parent.Location());
+                return shapes->FindKey(index).Moved(parent.Location());
         }
 
         int count() const {
-            return shapes.Extent();
+            return shapes->Extent();
         }
 
         friend Cache;
@@ -415,18 +638,20 @@ public:
         :shape(s.Located(TopLoc_Location()))
     {}
 
+    void initTopology() {
+        std::call_once(topologyFlag, [this]() {
+            topology = ShapeTopology::get(shape);
+            for(int type=0; type<=TopAbs_SHAPE; ++type) {
+                infos[type].owner = this;
+                infos[type].shapes = &topology->shapes((TopAbs_ShapeEnum)type);
+            }
+        });
+    }
+
     Info &getInfo(TopAbs_ShapeEnum type, bool clearTopoShapes=false) {
+        initTopology();
         auto &info = infos[type];
-        if(!info.owner) {
-            info.owner = this;
-            if(!shape.IsNull()) {
-                if(type == TopAbs_SHAPE) {
-                    for(TopoDS_Iterator it(shape);it.More();it.Next())
-                        info.shapes.Add(it.Value());
-                }else
-                    TopExp::MapShapes(shape, type, info.shapes);
-            }
-        }else if(clearTopoShapes)
+        if(clearTopoShapes)
             info.topoShapes.clear();
         return info;
     }
@@ -457,29 +682,21 @@ public:
             return ret;
 
         auto &info = getInfo(type);
-
-        auto &ainfo = info.ancestors[subshape.ShapeType()];
-        if(!ainfo.inited) {
-            ainfo.inited = true;
-            TopExp::MapShapesAndAncestors(shape, subshape.ShapeType(), type, ainfo.shapes);
-        }
-        int index;
-        if(parent.Location().IsIdentity())
-            index = ainfo.shapes.FindIndex(subshape);
-        else
-            index = ainfo.shapes.FindIndex(info.stripLocation(parent,subshape));
+        auto subtype = subshape.ShapeType();
+        int index = getInfo(subtype).find(parent,subshape);
         if(!index)
             return ret;
-        const auto &shapes = ainfo.shapes.FindFromIndex(index);
-        if(!shapes.Extent())
+        int count;
+        const int *indices = topology->findAncestors(subtype, index, type, count);
+        if(!count)
             return ret;
 
         if(ancestors) {
-            ancestors->reserve(ancestors->size()+shapes.Extent());
-            for(TopTools_ListIteratorOfListOfShape it(shapes);it.More();it.Next())
-                ancestors->push_back(it.Value().Moved(parent.Location()));
+            ancestors->reserve(ancestors->size()+count);
+            for(int i=0; i<count; ++i)
+                ancestors->push_back(info.find(parent,indices[i]));
         }
-        return shapes.First().Moved(parent.Location());
+        return info.find(parent,indices[0]);
     }
 
     std::size_t getMemSize();
@@ -2402,6 +2619,205 @@ TopoShape &TopoShape::makEShell(bool silent, const char *op) {
     return *this;
 }
 
+#if OCC_VERSION_HEX >= 0x070000
+
+// Group the shapes whose bounding boxes overlap, directly or through other
+// shapes. Shapes of different groups cannot interfere in a boolean operation.
+static std::vector<std::vector<int> > clusterShapes(const std::vector<TopoShape> &shapes,
+                                                    std::vector<Bnd_Box> &bounds)
+{
+    int count = (int)shapes.size();
+    std::vector<std::vector<int> > clusters;
+    bounds.assign(count, Bnd_Box());
+    Bnd_Box total;
+    for(int i=0;i<count;++i) {
+        BRepBndLib::Add(shapes[i].getShape(), bounds[i]);
+        if(bounds[i].IsVoid()) {
+            clusters.emplace_back();
+            for(int j=0;j<count;++j)
+                clusters.back().push_back(j);
+            return clusters;
+        }
+        bounds[i].SetGap(Precision::Confusion());
+        total.Add(bounds[i]);
+    }
+
+    // sweep along the longest extent of all boxes
+    double xMin, yMin, zMin, xMax, yMax, zMax;
+    total.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+    int axis = 0;
+    if(yMax - yMin > xMax - xMin)
+        axis = 1;
+    if(zMax - zMin > std::max(xMax - xMin, yMax - yMin))
+        axis = 2;
+    std::vector<double> lower(count), upper(count);
+    std::vector<int> order(count);
+    for(int i=0;i<count;++i) {
+        double bMin[3], bMax[3];
+        bounds[i].Get(bMin[0], bMin[1], bMin[2], bMax[0], bMax[1], bMax[2]);
+        lower[i] = bMin[axis];
+        upper[i] = bMax[axis];
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return lower[a] < lower[b];
+    });
+
+    std::vector<int> parent(count);
+    for(int i=0;i<count;++i)
+        parent[i] = i;
+    auto find = [&](int i) {
+        while(parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    for(int i=0;i<count;++i) {
+        int a = order[i];
+        for(int j=i+1; j<count && lower[order[j]] <= upper[a]; ++j) {
+            int b = order[j];
+            if(!bounds[a].IsOut(bounds[b])) {
+                int ra = find(a), rb = find(b);
+                if(ra != rb)
+                    parent[std::max(ra,rb)] = std::min(ra,rb);
+            }
+        }
+    }
+
+    // clusters are ordered by their first shape, and so are their members
+    std::vector<int> clusterIndex(count, -1);
+    for(int i=0;i<count;++i) {
+        int root = find(i);
+        if(clusterIndex[root] < 0) {
+            clusterIndex[root] = (int)clusters.size();
+            clusters.emplace_back();
+        }
+        clusters[clusterIndex[root]].push_back(i);
+    }
+    return clusters;
+}
+
+struct MapperClusters: Part::TopoShape::Mapper {
+    const std::vector<std::unique_ptr<BRepAlgoAPI_Fuse> > &makers;
+    TopTools_DataMapOfShapeInteger owners;
+
+    MapperClusters(const std::vector<std::unique_ptr<BRepAlgoAPI_Fuse> > &makers)
+        :makers(makers)
+    {}
+
+    void addOwner(const TopoDS_Shape &shape, int cluster) {
+        TopTools_IndexedMapOfShape subShapes;
+        TopExp::MapShapes(shape, subShapes);
+        for(int i=1; i<=subShapes.Extent(); ++i)
+            owners.Bind(subShapes(i), cluster);
+    }
+
+    const BRepAlgoAPI_Fuse *owner(const TopoDS_Shape &s) const {
+        if(!owners.IsBound(s))
+            return nullptr;
+        return makers[owners.Find(s)].get();
+    }
+
+    virtual const std::vector<TopoDS_Shape> &modified(const TopoDS_Shape &s) const override {
+        _res.clear();
+        auto mk = owner(s);
+        if(mk) {
+            try {
+                TopTools_ListIteratorOfListOfShape it;
+                for (it.Initialize(const_cast<BRepAlgoAPI_Fuse*>(mk)->Modified(s)); it.More(); it.Next())
+                    _res.push_back(it.Value());
+            } catch (const Standard_Failure & e) {
+                if (FC_LOG_INSTANCE.isEnabled(FC_LOGLEVEL_LOG))
+                    FC_WARN("Exception on shape mapper: " << e.GetMessageString());
+            }
+        }
+        return _res;
+    }
+    virtual const std::vector<TopoDS_Shape> &generated(const TopoDS_Shape &s) const override {
+        _res.clear();
+        auto mk = owner(s);
+        if(mk) {
+            try {
+                TopTools_ListIteratorOfListOfShape it;
+                for (it.Initialize(const_cast<BRepAlgoAPI_Fuse*>(mk)->Generated(s)); it.More(); it.Next())
+                    _res.push_back(it.Value());
+            } catch (const Standard_Failure & e) {
+                if (FC_LOG_INSTANCE.isEnabled(FC_LOGLEVEL_LOG))
+                    FC_WARN("Exception on shape mapper: " << e.GetMessageString());
+            }
+        }
+        return _res;
+    }
+};
+
+// Fuse many shapes by fusing each group of interacting shapes on its own,
+// concurrently, and putting the group results together in one compound.
+// The element map is built once for the whole result, as if it came from
+// a single fuse. Returns false if clustering does not help or any of the
+// group fusions fails, the caller then does a plain fuse.
+static bool clusteredFuse(TopoShape &res, const std::vector<TopoShape> &inputs,
+        const std::vector<TopoShape> &sources, const char *op)
+{
+    std::vector<Bnd_Box> bounds;
+    auto clusters = clusterShapes(inputs, bounds);
+    if(clusters.size() < 2)
+        return false;
+
+    std::vector<std::unique_ptr<BRepAlgoAPI_Fuse> > makers(clusters.size());
+    for(size_t c=0; c<clusters.size(); ++c) {
+        auto &members = clusters[c];
+        if(members.size() < 2)
+            continue;
+        makers[c].reset(new BRepAlgoAPI_Fuse);
+        makers[c]->SetRunParallel(true);
+        makers[c]->SetNonDestructive(Standard_True);
+        TopTools_ListOfShape shapeArguments,shapeTools;
+        shapeArguments.Append(inputs[members[0]].getShape());
+        for(size_t i=1; i<members.size(); ++i)
+            shapeTools.Append(inputs[members[i]].getShape());
+        makers[c]->SetArguments(shapeArguments);
+        makers[c]->SetTools(shapeTools);
+    }
+
+    std::vector<char> failed(clusters.size(), 0);
+    auto build = [&](int c) {
+        if(!makers[c])
+            return;
+        try {
+            makers[c]->Build();
+            if(!makers[c]->IsDone())
+                failed[c] = 1;
+        } catch (...) {
+            failed[c] = 1;
+        }
+    };
+    OSD_Parallel::For(0, (int)clusters.size(), build);
+    for(auto f : failed) {
+        if(f)
+            return false;
+    }
+
+    BRep_Builder builder;
+    TopoDS_Compound comp;
+    builder.MakeCompound(comp);
+    MapperClusters mapper(makers);
+    for(size_t c=0; c<clusters.size(); ++c) {
+        if(!makers[c]) {
+            builder.Add(comp, inputs[clusters[c][0]].getShape());
+            continue;
+        }
+        for(int i : clusters[c])
+            mapper.addOwner(inputs[i].getShape(), (int)c);
+        for(TopoDS_Iterator it(makers[c]->Shape()); it.More(); it.Next())
+            builder.Add(comp, it.Value());
+    }
+    res.makESHAPE(comp, mapper, sources, op);
+    return true;
+}
+
+#endif // OCC_VERSION_HEX >= 0x070000
+
 TopoShape &TopoShape::makEShape(const char *maker, 
         const std::vector<TopoShape> &shapes, const char *op, double tol)
 {
@@ -2567,6 +2983,41 @@ TopoShape &TopoShape::makEShape(const char *maker,
     return *this;
 #else
 
+    // Large boolean operations: fuse groups of interacting shapes separately
+    // and skip cutting tools that do not reach the object at all.
+    std::vector<char> skipTools;
+#if OCC_VERSION_HEX >= 0x070000
+    int clusterThreshold = PartParams::BooleanClusterThreshold();
+    if(tol <= 0.0 && clusterThreshold > 0 && (int)inputs.size() >= clusterThreshold) {
+        if(strcmp(maker, TOPOP_FUSE)==0) {
+            if(clusteredFuse(*this, inputs, shapes, op)) {
+                if(buildShell)
+                    makEShell();
+                return *this;
+            }
+        } else if(strcmp(maker, TOPOP_CUT)==0) {
+            Bnd_Box objectBound;
+            BRepBndLib::Add(inputs[0].getShape(), objectBound);
+            if(!objectBound.IsVoid()) {
+                objectBound.SetGap(Precision::Confusion());
+                skipTools.assign(inputs.size(), 0);
+                int kept = 0;
+                for(size_t j=1; j<inputs.size(); ++j) {
+                    Bnd_Box bound;
+                    BRepBndLib::Add(inputs[j].getShape(), bound);
+                    if(!bound.IsVoid() && bound.IsOut(objectBound))
+                        skipTools[j] = 1;
+                    else
+                        ++kept;
+                }
+                // OCC wants at least one tool
+                if(!kept)
+                    skipTools[1] = 0;
+            }
+        }
+    }
+#endif
+
     std::unique_ptr<BRepAlgoAPI_BooleanOperation> mk;
     if(strcmp(maker, TOPOP_FUSE)==0) 
         mk.reset(new BRepAlgoAPI_Fuse);
@@ -2594,6 +3045,8 @@ TopoShape &TopoShape::makEShape(const char *maker,
             HANDLE_NULL_INPUT;
         if(++i == 0)
             shapeArguments.Append(shape.getShape());
+        else if (skipTools.size() && skipTools[i])
+            continue;
         else if (tol > 0.0) {
             auto & s = _shapes[i];
             // workaround for http://dev.opencascade.org/index.php?q=node/1056#comment-520
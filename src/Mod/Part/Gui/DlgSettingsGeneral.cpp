@@ -280,6 +280,7 @@ void DlgImportExportStep::saveSettings()
     ui->checkBoxExportHiddenObj->onSave();
     ui->checkBoxExportLegacy->onSave();
     ui->checkBoxKeepPlacement->onSave();
+    ui->checkBoxExportInstancing->onSave();
     ui->checkBoxImportHiddenObj->onSave();
     ui->checkBoxLegacyImporter->onSave();
     ui->checkBoxUseAppPart->onSave();
@@ -325,6 +326,7 @@ void DlgImportExportStep::loadSettings()
     ui->checkBoxExportHiddenObj->onRestore();
     ui->checkBoxExportLegacy->onRestore();
     ui->checkBoxKeepPlacement->onRestore();
+    ui->checkBoxExportInstancing->onRestore();
     ui->checkBoxImportHiddenObj->onRestore();
     ui->checkBoxLegacyImporter->onRestore();
     ui->checkBoxUseAppPart->onRestore();
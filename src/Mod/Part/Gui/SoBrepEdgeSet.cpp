@@ -54,6 +54,7 @@
 # include <Inventor/errors/SoReadError.h>
 # include <Inventor/details/SoFaceDetail.h>
 # include <Inventor/details/SoLineDetail.h>
+# include <Inventor/details/SoPointDetail.h>
 # include <Inventor/misc/SoState.h>
 #endif
 
@@ -102,6 +103,9 @@ void SoBrepEdgeSet::notify(SoNotList * list)
             if(cindices[i] < 0)
                 this->segments.push_back(i+1);
         }
+        this->pickChunks.clear();
+        this->pickTree.clear();
+        this->pickTreeNodeId = 0;
     }
     SoIndexedLineSet::notify(list);
 }
@@ -495,6 +499,94 @@ void SoBrepEdgeSet::doAction(SoAction* action)
     inherited::doAction(action);
 }
 
+void SoBrepEdgeSet::buildPickTree(const SoCoordinateElement *coords) {
+    if (coords->getNodeId() == pickTreeNodeId)
+        return;
+    pickTreeNodeId = coords->getNodeId();
+    pickChunks.clear();
+    pickTree.clear();
+
+    // Split each polyline into chunks of consecutive segments. Adjacent
+    // chunks share one vertex.
+    const int chunkSize = 16;
+    const int32_t *cindices = this->coordIndex.getValues(0);
+    int numindices = this->coordIndex.getNum();
+    int numverts = coords->getNum();
+    std::vector<SbBox3f> boxes;
+    int line = 0;
+    for (int i=0; i<numindices; ) {
+        int end = i;
+        while (end < numindices && cindices[end] >= 0)
+            ++end;
+        for (int start=i; start+1<end; start+=chunkSize) {
+            int count = std::min(chunkSize+1, end-start);
+            SbBox3f box;
+            for (int j=start; j<start+count; ++j) {
+                if (cindices[j] < numverts)
+                    box.extendBy(coords->get3(cindices[j]));
+            }
+            pickChunks.push_back({line, start, count});
+            boxes.push_back(box);
+        }
+        ++line;
+        i = end + 1;
+    }
+    pickTree.build(boxes);
+}
+
+void SoBrepEdgeSet::rayPick(SoRayPickAction *action) {
+    int threshold = Gui::ViewParams::getSelectionPickThreshold();
+    if (!threshold || this->coordIndex.getNum() <= threshold || this->vertexProperty.getValue()) {
+        inherited::rayPick(action);
+        return;
+    }
+
+    if (!shouldRayPick(action))
+        return;
+
+    computeObjectSpaceRay(action);
+
+    SoState *state = action->getState();
+    if (getBoundingBoxCache() && getBoundingBoxCache()->isValid(state)) {
+        SbBox3f box = getBoundingBoxCache()->getProjectedBox();
+        if(box.isEmpty() || !action->intersect(box,TRUE))
+            return;
+    }
+
+    auto coords = SoCoordinateElement::getInstance(state);
+    if (!coords)
+        return;
+
+    // Only generate the line segments of the chunks near the ray. The tree
+    // is built on first pick, and cached until geometry changes.
+    buildPickTree(coords);
+    std::vector<int> chunks;
+    pickTree.query(action, chunks);
+
+    const int32_t *cindices = this->coordIndex.getValues(0);
+    int numverts = coords->getNum();
+
+    SoPrimitiveVertex vertex;
+    SoPointDetail pointDetail;
+    SoLineDetail lineDetail;
+    vertex.setDetail(&pointDetail);
+
+    for (int i : chunks) {
+        const auto &chunk = pickChunks[i];
+        lineDetail.setLineIndex(chunk.line);
+        this->beginShape(action, SoShape::LINE_STRIP, &lineDetail);
+        for (int j=chunk.start; j<chunk.start+chunk.count; ++j) {
+            int v = cindices[j];
+            if (v >= numverts)
+                continue;
+            pointDetail.setCoordinateIndex(v);
+            vertex.setPoint(coords->get3(v));
+            this->shapeVertex(&vertex);
+        }
+        this->endShape();
+    }
+}
+
 SoDetail * SoBrepEdgeSet::createLineSegmentDetail(SoRayPickAction * action,
                                                   const SoPrimitiveVertex * v1,
                                                   const SoPrimitiveVertex * v2,
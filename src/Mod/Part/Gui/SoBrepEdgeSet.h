@@ -38,6 +38,7 @@
 #include <memory>
 #include <set>
 #include <Gui/SoFCSelectionContext.h>
+#include <Gui/SoFCSelectionAction.h>
 
 class SoCoordinateElement;
 class SoGLCoordinateElement;
@@ -72,6 +73,7 @@ protected:
         SoPickedPoint *pp);
 
     virtual void getBoundingBox(SoGetBoundingBoxAction * action);
+    virtual void rayPick(SoRayPickAction *action);
 
     virtual void notify(SoNotList * list);
 
@@ -85,6 +87,7 @@ private:
     void _renderSelection(SoGLRenderAction *action, bool checkColor, SbColor color, unsigned pattern, bool push);
 
     bool isSelected(SelContextPtr ctx);
+    void buildPickTree(const SoCoordinateElement *coords);
 
 private:
     SelContextPtr selContext;
@@ -92,6 +95,16 @@ private:
     Gui::SoFCSelectionCounter selCounter;
     std::vector<SoNode*> siblings;
     std::vector<int> segments;
+
+    // Ray pick acceleration, built on first pick and cleared on geometry change
+    struct PickChunk {
+        int32_t line;
+        int32_t start;
+        int32_t count;
+    };
+    std::vector<PickChunk> pickChunks;
+    Gui::SoFCRayPickTree pickTree;
+    uint32_t pickTreeNodeId = 0;
 };
 
 } // namespace PartGui
@@ -360,6 +360,9 @@ void SoBrepFaceSet::onPartIndexChange() {
     partBBoxes.clear();
     indexOffset.clear();
     partIndexMap.clear();
+    pickChunks.clear();
+    pickTree.clear();
+    pickTreeNodeId = 0;
 }
 
 void SoBrepFaceSet::buildPartIndexCache() {
@@ -1256,6 +1259,53 @@ void SoBrepFaceSet::buildPartBBoxes(SoState *state) {
     }
 }
 
+void SoBrepFaceSet::buildPickTree(SoAction *action) {
+    SoState *state = action->getState();
+    if (this->vertexProperty.getValue()) {
+        state->push();
+        this->vertexProperty.getValue()->doAction(action);
+    }
+
+    auto coords = SoCoordinateElement::getInstance(state);
+    if (coords && coords->getNodeId() != pickTreeNodeId) {
+        pickTreeNodeId = coords->getNodeId();
+        pickChunks.clear();
+        pickTree.clear();
+
+        buildPartIndexCache();
+
+        // Group consecutive triangles of the same part into chunks. Triangles
+        // of a face are usually generated close together by the mesher, so
+        // the chunks are reasonably tight.
+        const int chunkSize = 16;
+        const int32_t *cindices = coordIndex.getValues(0);
+        int numindices = coordIndex.getNum();
+        int numverts = coords->getNum();
+        int numparts = partIndex.getNum();
+        std::vector<SbBox3f> boxes;
+        for (int id=0; id<numparts; ++id) {
+            int fend = indexOffset[id+1];
+            for (int f=indexOffset[id]; f<fend; f+=chunkSize) {
+                int count = std::min(chunkSize, fend-f);
+                if ((f+count)*4 > numindices)
+                    break;
+                SbBox3f box;
+                for (int i=f*4, end=(f+count)*4; i<end; ++i) {
+                    int v = cindices[i];
+                    if (v >= 0 && v < numverts)
+                        box.extendBy(coords->get3(v));
+                }
+                pickChunks.push_back({id, f, count});
+                boxes.push_back(box);
+            }
+        }
+        pickTree.build(boxes);
+    }
+
+    if (this->vertexProperty.getValue())
+        state->pop();
+}
+
 void SoBrepFaceSet::sortParts(SoState *state, SelContextPtr ctx, SelContextPtr ctx2,
                               const float *trans, int numtrans, bool shadow)
 {
@@ -2650,16 +2700,11 @@ void SoBrepFaceSet::rayPick(SoRayPickAction *action) {
     int threshold = Gui::ViewParams::getSelectionPickThreshold();
     int numparts = partIndex.getNum();
 
-    if(threshold && numparts && indexOffset[numparts-1]/numparts > threshold) {
-        // If face per part exceeds the threshold, then force computes bbox per
-        // part. The computed bboxes will be cached until partIndex changes
-        buildPartBBoxes(state);
-    }
-
     Binding mbind = this->findMaterialBinding(state);
     Binding nbind = this->findNormalBinding(state);
 
-    if(!threshold || numparts!=(int)partBBoxes.size() 
+    // generatePrimitivesRange() does not support per face binding
+    if(!threshold || !numparts || indexOffset[numparts] <= threshold
             || mbind==PER_FACE || mbind==PER_FACE_INDEXED 
             || nbind==PER_FACE || nbind==PER_FACE_INDEXED ) 
     {
@@ -2668,24 +2713,41 @@ void SoBrepFaceSet::rayPick(SoRayPickAction *action) {
         return;
     }
 
-    if(ctx2 && !ctx2->isSelectAll()) {
-        for(auto &v : ctx2->selectionIndex) {
-            int id = v.first;
-            if(id<0 || id>=numparts)
-                continue;
-            auto &box = partBBoxes[id];
-            if(box.isEmpty() || !action->intersect(box,TRUE))
-                continue;
-            pick(id);
-        }
-    } else {
-        for(int id=0;id<numparts;++id) {
-            auto &box = partBBoxes[id];
-            if(box.isEmpty() || !action->intersect(box,TRUE))
-                continue;
-            pick(id);
-        }
-        FC_TIME_TRACE(t,"pick new");
+    if(!ctx2 || ctx2->isSelectAll()) {
+        // Only generate primitives of the triangle chunks near the ray. The
+        // tree is built on first pick, and cached until geometry changes.
+        buildPickTree(action);
+        std::vector<int> chunks;
+        pickTree.query(action, chunks);
+        for(int i : chunks) {
+            const auto &chunk = pickChunks[i];
+            this->generatePrimitivesRange(action, chunk.part, chunk.face,
+                    chunk.face*4, (chunk.face+chunk.count)*4);
+        }
+        FC_TIME_TRACE(t,"pick tree " << chunks.size() << '/' << pickChunks.size());
+        return;
+    }
+
+    if(indexOffset[numparts-1]/numparts > threshold) {
+        // If face per part exceeds the threshold, then force computes bbox per
+        // part. The computed bboxes will be cached until partIndex changes
+        buildPartBBoxes(state);
+    }
+
+    if(numparts!=(int)partBBoxes.size()) {
+        generatePrimitives(action);
+        FC_TIME_TRACE(t,"pick");
+        return;
+    }
+
+    for(auto &v : ctx2->selectionIndex) {
+        int id = v.first;
+        if(id<0 || id>=numparts)
+            continue;
+        auto &box = partBBoxes[id];
+        if(box.isEmpty() || !action->intersect(box,TRUE))
+            continue;
+        pick(id);
     }
 }
 
@@ -36,6 +36,7 @@
 #include <vector>
 #include <memory>
 #include <Gui/SoFCSelectionContext.h>
+#include <Gui/SoFCSelectionAction.h>
 
 class SoGLCoordinateElement;
 class SoTextureCoordinateBundle;
@@ -159,6 +160,7 @@ private:
     void sortParts(SoState *state, SelContextPtr ctx, SelContextPtr ctx2,
                    const float *trans, int numtrans, bool shadow);
     void buildPartBBoxes(SoState *state);
+    void buildPickTree(SoAction *action);
     void buildPartIndexCache();
     int getPartFromFace(int index);
     bool isHighlightAll(const SelContextPtr &ctx);
@@ -185,6 +187,16 @@ private:
     SoFieldSensor partIndexSensor;
     std::vector<SbBox3f> partBBoxes;
 
+    // Ray pick acceleration, built on first pick and cleared on geometry change
+    struct PickChunk {
+        int32_t part;
+        int32_t face;
+        int32_t count;
+    };
+    std::vector<PickChunk> pickChunks;
+    Gui::SoFCRayPickTree pickTree;
+    uint32_t pickTreeNodeId = 0;
+
     // Define some VBO pointer for the current mesh
     class VBO;
     std::unique_ptr<VBO> pimpl;
@@ -2050,6 +2050,36 @@ void ViewProviderPartExt::forceUpdate(bool enable) {
         --forceUpdateCount;
 }
 
+bool ViewProviderPartExt::releaseVisual() {
+    if(isShow() || isUpdateForced() || VisualTouched)
+        return false;
+
+    Gui::SoUpdateVBOAction action;
+    action.apply(this->faceset);
+
+    Gui::SoSelectionElementAction saction(Gui::SoSelectionElementAction::None);
+    saction.apply(this->faceset);
+    saction.apply(this->lineset);
+    saction.apply(this->nodeset);
+
+    Gui::SoHighlightElementAction haction;
+    haction.apply(this->faceset);
+    haction.apply(this->lineset);
+    haction.apply(this->nodeset);
+
+    coords  ->point      .setNum(0);
+    pcoords ->point      .setNum(0);
+    norm    ->vector     .setNum(0);
+    faceset ->coordIndex .setNum(0);
+    faceset ->partIndex  .setNum(0);
+    lineset ->coordIndex .setNum(0);
+    nodeset ->startIndex .setValue(0);
+
+    // Rebuilt on next show, see onChanged() and forceUpdate()
+    VisualTouched = true;
+    return true;
+}
+
 PyObject* ViewProviderPartExt::getPyObject()
 {
     if (!pyViewObject)
@@ -154,6 +154,7 @@ public:
         return forceUpdateCount>0;
     }
     virtual void forceUpdate(bool enable = true) override;
+    virtual bool releaseVisual() override;
 
     virtual bool allowOverride(const App::DocumentObject &) const override;
 
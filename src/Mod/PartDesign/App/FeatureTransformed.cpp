@@ -399,11 +399,7 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
         int idx = startIndices[i];
         bool fuse = fuses[i++];
 
-        // Transform the add/subshape and collect the resulting shapes for overlap testing
-        /*typedef std::vector<std::vector<gp_Trsf>::const_iterator> trsf_it_vec;
-        trsf_it_vec v_transformations;
-        std::vector<TopoDS_Shape> v_transformedShapes;*/
-
+        std::vector<TopoShape> tools;
         std::vector<gp_Trsf>::const_iterator t = transformations.begin();
         if (idx != 0)
             ++t; // Skip first transformation, which is always the identity transformation
@@ -417,74 +413,61 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
                 return new App::DocumentObjectExecReturn("Transformed: Linked shape object is empty");
 
             try {
-                shapeCopy = shapeCopy.makETransform(*t, ss.str().c_str(), true);
+                tools.push_back(shapeCopy.makETransform(*t, ss.str().c_str(), true));
             }catch(Standard_Failure &) {
                 std::string msg("Transformation failed ");
                 msg += sub;
                 return new App::DocumentObjectExecReturn(msg.c_str());
             }
+        }
+        if (tools.empty())
+            continue;
 
-            try {
-                // Intersection checking for additive shape is redundant.
-                // Because according to CheckIntersection() source code, it is
-                // implemented using fusion and counting of the resulting
-                // solid, which will be done in the following modeling step
-                // anyway.
-                //
-                // There is little reason for doing intersection checking on
-                // subtractive shape either, because it does not produce
-                // multiple solids.
-                //
-                // if (!Part::checkIntersection(support, mkTrf.Shape(), false, true)) 
-
-
-                if (fuse) {
-                    // We cannot wait to fuse a transformation with the support until all the transformations are done,
-                    // because the "support" potentially changes with every transformation, basically when checking intersection
-                    // above you need:
-                    // 1. The original support
-                    // 2. Any extra support gained by any previous transformation of any previous feature (multi-feature transform)
-                    // 3. Any extra support gained by any previous transformation of this feature (feature multi-trasform)
-                    //
-                    // Therefore, if the transformation succeeded, then we fuse it with the support now, before checking the intersection
-                    // of the next transformation.
-                    
-                    /*v_transformations.push_back(t);
-                    v_transformedShapes.push_back(mkTrf.Shape());*/
-    
-                    // Note: Transformations that do not intersect the support are ignored in the overlap tests
-                    
-                    //insert scheme here.
-                    /*TopoDS_Compound compoundTool;
-                    std::vector<TopoDS_Shape> individualTools;
-                    divideTools(v_transformedShapes, individualTools, compoundTool);*/
-                    
-                    // Fuse/Cut the compounded transformed shapes with the support
-                    //TopoDS_Shape result;
-                    
-                    result.makEFuse({support,shapeCopy});
-                    // we have to get the solids (fuse sometimes creates compounds)
-                    support = this->getSolid(result);
-                    // lets check if the result is a solid
-                    if (support.isNull()) {
-                        std::string msg("Resulting shape is not a solid: ");
-                        msg += sub;
-                        return new App::DocumentObjectExecReturn(msg.c_str());
-                    }
-
-                } else {
-                    result.makECut({support,shapeCopy});
-                    support = result;
+        try {
+            // Intersection checking for additive shape is redundant.
+            // Because according to CheckIntersection() source code, it is
+            // implemented using fusion and counting of the resulting
+            // solid, which will be done in the following modeling step
+            // anyway.
+            //
+            // There is little reason for doing intersection checking on
+            // subtractive shape either, because it does not produce
+            // multiple solids.
+            //
+            // if (!Part::checkIntersection(support, mkTrf.Shape(), false, true)) 
+
+            // All instances of this original go into a single boolean
+            // operation with the support. Fusing them one at a time makes
+            // every step intersect the instance with the ever growing
+            // support, which does not scale to large patterns. The instances
+            // are always passed as separate arguments in pattern order, so
+            // that the element names of the result do not depend on which
+            // instances happen to overlap. OCC already skips the interference
+            // tests of arguments whose bounding boxes are apart.
+            tools.insert(tools.begin(), support);
+            if (fuse) {
+                result.makEFuse(tools);
+                // we have to get the solids (fuse sometimes creates compounds)
+                support = this->getSolid(result);
+                // lets check if the result is a solid
+                if (support.isNull()) {
+                    std::string msg("Resulting shape is not a solid: ");
+                    msg += sub;
+                    return new App::DocumentObjectExecReturn(msg.c_str());
                 }
-            } catch (Standard_Failure& e) {
-                // Note: Ignoring this failure is probably pointless because if the intersection check fails, the later
-                // fuse operation of the transformation result will also fail
-        
-                std::string msg("Transformation: Intersection check failed");
-                if (e.GetMessageString() != NULL)
-                    msg += std::string(": '") + e.GetMessageString() + "'";
-                return new App::DocumentObjectExecReturn(msg.c_str());
+
+            } else {
+                result.makECut(tools);
+                support = result;
             }
+        } catch (Standard_Failure& e) {
+            // Note: Ignoring this failure is probably pointless because if the intersection check fails, the later
+            // fuse operation of the transformation result will also fail
+    
+            std::string msg("Transformation: Intersection check failed");
+            if (e.GetMessageString() != NULL)
+                msg += std::string(": '") + e.GetMessageString() + "'";
+            return new App::DocumentObjectExecReturn(msg.c_str());
         }
     }
     result = refineShapeIfActive(result);
@@ -507,61 +490,6 @@ TopoShape Transformed::refineShapeIfActive(const TopoShape& oldShape) const
     return oldShape;
 }
 
-void Transformed::divideTools(const std::vector<TopoDS_Shape> &toolsIn, std::vector<TopoDS_Shape> &individualsOut,
-                              TopoDS_Compound &compoundOut) const
-{
-    typedef std::pair<TopoDS_Shape, Bnd_Box> ShapeBoundPair;
-    typedef std::list<ShapeBoundPair> PairList;
-    typedef std::vector<ShapeBoundPair> PairVector;
-
-    PairList pairList;
-
-    std::vector<TopoDS_Shape>::const_iterator it;
-    for (it = toolsIn.begin(); it != toolsIn.end(); ++it) {
-        Bnd_Box bound;
-        BRepBndLib::Add(*it, bound);
-        bound.SetGap(0.0);
-        ShapeBoundPair temp = std::make_pair(*it, bound);
-        pairList.push_back(temp);
-    }
-
-    BRep_Builder builder;
-    builder.MakeCompound(compoundOut);
-
-    while(!pairList.empty()) {
-        PairVector currentGroup;
-        currentGroup.push_back(pairList.front());
-        pairList.pop_front();
-        PairList::iterator it = pairList.begin();
-        while(it != pairList.end()) {
-            PairVector::const_iterator groupIt;
-            bool found(false);
-            for (groupIt = currentGroup.begin(); groupIt != currentGroup.end(); ++groupIt) {
-                if (!(*it).second.IsOut((*groupIt).second)) {//touching means is out.
-                    found = true;
-                    break;
-                }
-            }
-            if (found) {
-                currentGroup.push_back(*it);
-                pairList.erase(it);
-                it=pairList.begin();
-                continue;
-            }
-            ++it;
-        }
-
-        if (currentGroup.size() == 1) {
-            builder.Add(compoundOut, currentGroup.front().first);
-        }
-        else {
-            PairVector::const_iterator groupIt;
-            for (groupIt = currentGroup.begin(); groupIt != currentGroup.end(); ++groupIt)
-                individualsOut.push_back((*groupIt).first);
-        }
-    }
-}
-
 void Transformed::onDocumentRestored() {
     if(OriginalSubs.getValues().empty() && Originals.getSize()) {
         std::vector<std::string> subs(Originals.getSize());
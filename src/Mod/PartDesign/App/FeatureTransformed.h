@@ -105,8 +105,6 @@ protected:
         Base::XMLReader &reader, const char * TypeName, App::Property * prop);
     virtual void positionBySupport(void);
     TopoShape refineShapeIfActive(const TopoShape&) const;
-    void divideTools(const std::vector<TopoDS_Shape> &toolsIn, std::vector<TopoDS_Shape> &individualsOut,
-		     TopoDS_Compound &compoundOut) const; 
 
     virtual void setupObject ();
 
@@ -194,9 +194,9 @@ void PointKernel::SaveDocFile (Base::Writer &writer) const
     uint32_t uCt = (uint32_t)size();
     str << uCt;
     // store the data without transforming it
-    for (std::vector<value_type>::const_iterator it = _Points.begin(); it != _Points.end(); ++it) {
-        str << it->x << it->y << it->z;
-    }
+    static_assert(sizeof(value_type) == 3*sizeof(float_type), "Unexpected point layout");
+    if (!_Points.empty())
+        str.write(&_Points[0].x, 3*_Points.size());
 }
 
 void PointKernel::Restore(Base::XMLReader &reader)
@@ -232,11 +232,8 @@ void PointKernel::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt = 0;
     str >> uCt;
     _Points.resize(uCt);
-    for (unsigned long i=0; i < uCt; i++) {
-        float x, y, z;
-        str >> x >> y >> z;
-        _Points[i].Set(x,y,z);
-    }
+    if (uCt)
+        str.read(&_Points[0].x, 3*std::size_t(uCt));
 }
 
 void PointKernel::save(const char* file) const
@@ -27,6 +27,7 @@
 # include <unistd.h>
 #endif
 # include <sstream>
+# include <cstring>
 #endif
 
 
@@ -39,9 +40,9 @@
 #include <Base/Console.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
+#include <Base/Swap.h>
 
 #include <boost/shared_ptr.hpp>
-#include <boost/regex.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
@@ -62,59 +63,67 @@ void PointsAlgos::Load(PointKernel &points, const char *FileName)
         throw Base::RuntimeError("Unknown ending");
 }
 
-void PointsAlgos::LoadAscii(PointKernel &points, const char *FileName)
+namespace {
+// Reads the next decimal number of a line, special values like nan or inf
+// are not accepted
+bool readCoordinate(const char*& ptr, double& value)
 {
-    boost::regex rx("^\\s*([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                     "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                     "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    //boost::regex rx("(\\b[0-9]+\\.([0-9]+\\b)?|\\.[0-9]+\\b)");
-    //boost::regex rx("^\\s*(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s*$");
-    boost::cmatch what;
+    while (*ptr == ' ' || *ptr == '\t')
+        ptr++;
+    char c = *ptr;
+    if (!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.'))
+        return false;
+
+    char* end;
+    value = std::strtod(ptr, &end);
+    if (end == ptr)
+        return false;
+    ptr = end;
+    return true;
+}
+}
 
+void PointsAlgos::LoadAscii(PointKernel &points, const char *FileName)
+{
     Base::Vector3d pt;
-    int LineCnt=0;
     std::string line;
     Base::FileInfo fi(FileName);
 
-    Base::ifstream tmp_str(fi, std::ios::in);
+    Base::ifstream file(fi, std::ios::in | std::ios::binary);
 
-    // estimating size
-    while (std::getline(tmp_str,line))
-        LineCnt++;
+    // estimate the number of points from the file size instead of
+    // reading the whole file twice
+    file.seekg(0, std::ios::end);
+    std::streamoff fileSize = file.tellg();
+    file.seekg(0, std::ios::beg);
 
-    // resize the PointKernel
-    points.resize(LineCnt);
+    points.clear();
+    points.reserve(static_cast<std::size_t>(fileSize / 32));
 
-    Base::SequencerLauncher seq( "Loading points...", LineCnt );
-
-    // again to the beginning
-    Base::ifstream file(fi, std::ios::in);
-    LineCnt = 0;
+    Base::SequencerLauncher seq( "Loading points...", 100 );
+    std::size_t LineCnt = 0;
 
     try {
-        // read file
+        // read file, only lines with exactly three numbers are points
         while (std::getline(file, line)) {
-            if (boost::regex_match(line.c_str(), what, rx)) {
-                pt.x = std::atof(what[1].first);
-                pt.y = std::atof(what[4].first);
-                pt.z = std::atof(what[7].first);
-
-                points.setPoint(LineCnt,pt);
-                seq.next();
-                LineCnt++;
+            const char* ptr = line.c_str();
+            if (readCoordinate(ptr, pt.x) &&
+                readCoordinate(ptr, pt.y) &&
+                readCoordinate(ptr, pt.z)) {
+                while (*ptr == ' ' || *ptr == '\t' || *ptr == '\r')
+                    ptr++;
+                if (*ptr == '\0')
+                    points.push_back(pt);
             }
+
+            if ((++LineCnt & 0xffff) == 0 && fileSize > 0)
+                seq.setProgress(static_cast<std::size_t>(100 * file.tellg() / fileSize));
         }
     }
     catch (...) {
         points.clear();
         throw Base::BadFormatError("Reading in points failed.");
     }
-
-    // now remove the last points from the kernel
-    // Note: first we allocate memory corresponding to the number of lines (points and comments)
-    //       and read in the file twice. But then the size of the kernel is too high
-    if (LineCnt < (int)points.size())
-        points.erase(LineCnt, points.size());
 }
 
 // ----------------------------------------------------------------------------
@@ -214,7 +223,7 @@ public:
     virtual ~Converter() {
     }
     virtual std::string toString(float) const = 0;
-    virtual double toDouble(Base::InputStream&) const = 0;
+    virtual double toDouble(const char*, bool swapByteOrder) const = 0;
     virtual int getSizeOf() const = 0;
 };
 template <typename T>
@@ -228,9 +237,11 @@ public:
         oss << c;
         return oss.str();
     }
-    virtual double toDouble(Base::InputStream& str) const {
+    virtual double toDouble(const char* ptr, bool swapByteOrder) const {
         T c;
-        str >> c;
+        std::memcpy(&c, ptr, sizeof(T));
+        if (swapByteOrder)
+            Base::SwapEndian<T>(c);
         return static_cast<double>(c);
     }
     virtual int getSizeOf() const {
@@ -240,6 +251,160 @@ public:
 
 typedef boost::shared_ptr<Converter> ConverterPtr;
 
+// Stores the decoded fields of a point record straight into the point kernel
+// and the attribute vectors of a reader
+class FieldDecoder
+{
+public:
+    enum Target {
+        Skip, PointX, PointY, PointZ, NormalX, NormalY, NormalZ,
+        Intensity, Red, Green, Blue, Alpha, PackedUInt, PackedFloat
+    };
+
+    FieldDecoder(std::size_t numFields)
+        : targets(numFields, Skip)
+        , points(nullptr)
+        , normals(nullptr)
+        , intensity(nullptr)
+        , colors(nullptr)
+        , colorScale(1.0f)
+    {
+    }
+
+    std::size_t numFields() const {
+        return targets.size();
+    }
+
+    void set(std::size_t row, std::size_t col, double value) {
+        switch (targets[col]) {
+        case Skip:
+            break;
+        case PointX:
+            points[row].x = static_cast<float>(value);
+            break;
+        case PointY:
+            points[row].y = static_cast<float>(value);
+            break;
+        case PointZ:
+            points[row].z = static_cast<float>(value);
+            break;
+        case NormalX:
+            normals[row].x = static_cast<float>(value);
+            break;
+        case NormalY:
+            normals[row].y = static_cast<float>(value);
+            break;
+        case NormalZ:
+            normals[row].z = static_cast<float>(value);
+            break;
+        case Intensity:
+            intensity[row] = static_cast<float>(value);
+            break;
+        case Red:
+            colors[row].r = static_cast<float>(value) * colorScale;
+            break;
+        case Green:
+            colors[row].g = static_cast<float>(value) * colorScale;
+            break;
+        case Blue:
+            colors[row].b = static_cast<float>(value) * colorScale;
+            break;
+        case Alpha:
+            colors[row].a = static_cast<float>(value) * colorScale;
+            break;
+        case PackedUInt:
+            setPackedColor(row, static_cast<uint32_t>(value));
+            break;
+        case PackedFloat: {
+            // the color bits are stored in a float
+            float f = static_cast<float>(value);
+            uint32_t packed;
+            std::memcpy(&packed, &f, sizeof(packed));
+            setPackedColor(row, packed);
+            break;
+        }
+        }
+    }
+
+    std::vector<Target> targets;
+    Base::Vector3f* points;
+    Base::Vector3f* normals;
+    float* intensity;
+    App::Color* colors;
+    float colorScale;
+
+private:
+    void setPackedColor(std::size_t row, uint32_t packed) {
+        uint32_t a = (packed >> 24) & 0xff;
+        uint32_t r = (packed >> 16) & 0xff;
+        uint32_t g = (packed >> 8) & 0xff;
+        uint32_t b = packed & 0xff;
+        colors[row].set(static_cast<float>(r)/255.0f,
+                        static_cast<float>(g)/255.0f,
+                        static_cast<float>(b)/255.0f,
+                        static_cast<float>(a)/255.0f);
+    }
+};
+
+// Returns the index of the first of the given field names, or max_size
+std::size_t findField(const std::vector<std::string>& fields, const char* name,
+                      const char* altName = nullptr)
+{
+    std::vector<std::string>::const_iterator it;
+    it = std::find(fields.begin(), fields.end(), name);
+    if (it == fields.end() && altName)
+        it = std::find(fields.begin(), fields.end(), altName);
+    if (it == fields.end())
+        return std::numeric_limits<std::size_t>::max();
+    return std::distance(fields.begin(), it);
+}
+
+// Parses the whitespace separated numbers of a line into a record without
+// splitting the line into temporary strings. Returns false for a blank line.
+bool parseAsciiRow(const std::string& line, std::size_t row, FieldDecoder& data)
+{
+    std::size_t numFields = data.numFields();
+    const char* ptr = line.c_str();
+    for (std::size_t col = 0; col < numFields; col++) {
+        char* end;
+        double value = std::strtod(ptr, &end);
+        if (end == ptr) {
+            // fewer values than fields is accepted, garbage is not
+            while (*ptr == ' ' || *ptr == '\t' || *ptr == '\r')
+                ptr++;
+            if (*ptr != '\0')
+                throw Base::BadFormatError("Failed to read numeric value");
+            return col > 0;
+        }
+
+        data.set(row, col, value);
+        ptr = end;
+    }
+
+    return true;
+}
+
+// Reads numRecords binary records of recordSize bytes from the stream in
+// blocks and passes each record to the callback
+template <typename Func>
+void readBinaryBlocks(std::istream& inp, std::size_t numRecords, std::size_t recordSize, Func func)
+{
+    if (recordSize == 0)
+        return;
+    const std::size_t blockRecords = std::max<std::size_t>(1, (1 << 20) / recordSize);
+    std::vector<char> buffer(std::min(numRecords, blockRecords) * recordSize);
+    std::size_t record = 0;
+    while (record < numRecords) {
+        std::size_t count = std::min(numRecords - record, blockRecords);
+        inp.read(buffer.data(), static_cast<std::streamsize>(count * recordSize));
+        if (static_cast<std::size_t>(inp.gcount()) != count * recordSize)
+            throw Base::BadFormatError("Unexpected end of file");
+        for (std::size_t i=0; i<count; i++)
+            func(record + i, &buffer[i * recordSize]);
+        record += count;
+    }
+}
+
 class DataStreambuf : public std::streambuf
 {
 public:
@@ -517,139 +682,72 @@ void PlyReader::read(const std::string& filename)
     std::size_t offset = 0;
     std::size_t numPoints = readHeader(inp, format, offset, fields, types, sizes);
 
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, offset, data);
-    }
-    else if (format == "binary_little_endian") {
-        readBinary(false, inp, offset, types, sizes, data);
-    }
-    else if (format == "binary_big_endian") {
-        readBinary(true, inp, offset, types, sizes, data);
-    }
-
-    std::vector<std::string>::iterator it;
     std::size_t max_size = std::numeric_limits<std::size_t>::max();
+    std::size_t x = findField(fields, "x");
+    std::size_t y = findField(fields, "y");
+    std::size_t z = findField(fields, "z");
+    std::size_t normal_x = findField(fields, "normal_x", "nx");
+    std::size_t normal_y = findField(fields, "normal_y", "ny");
+    std::size_t normal_z = findField(fields, "normal_z", "nz");
+    std::size_t greyvalue = findField(fields, "intensity");
+    std::size_t red = findField(fields, "red");
+    std::size_t green = findField(fields, "green");
+    std::size_t blue = findField(fields, "blue");
+    std::size_t alpha = findField(fields, "alpha");
 
-    // x field
-    std::size_t x = max_size;
-    it = std::find(fields.begin(), fields.end(), "x");
-    if (it != fields.end())
-        x = std::distance(fields.begin(), it);
-
-    // y field
-    std::size_t y = max_size;
-    it = std::find(fields.begin(), fields.end(), "y");
-    if (it != fields.end())
-        y = std::distance(fields.begin(), it);
-
-    // z field
-    std::size_t z = max_size;
-    it = std::find(fields.begin(), fields.end(), "z");
-    if (it != fields.end())
-        z = std::distance(fields.begin(), it);
-
-    // normal x field
-    std::size_t normal_x = max_size;
-    it = std::find(fields.begin(), fields.end(), "normal_x");
-    if (it == fields.end())
-        it = std::find(fields.begin(), fields.end(), "nx");
-    if (it != fields.end())
-        normal_x = std::distance(fields.begin(), it);
-
-    // normal y field
-    std::size_t normal_y = max_size;
-    it = std::find(fields.begin(), fields.end(), "normal_y");
-    if (it == fields.end())
-        it = std::find(fields.begin(), fields.end(), "ny");
-    if (it != fields.end())
-        normal_y = std::distance(fields.begin(), it);
-
-    // normal z field
-    std::size_t normal_z = max_size;
-    it = std::find(fields.begin(), fields.end(), "normal_z");
-    if (it == fields.end())
-        it = std::find(fields.begin(), fields.end(), "nz");
-    if (it != fields.end())
-        normal_z = std::distance(fields.begin(), it);
-
-    // intensity field
-    std::size_t greyvalue = max_size;
-    it = std::find(fields.begin(), fields.end(), "intensity");
-    if (it != fields.end())
-        greyvalue = std::distance(fields.begin(), it);
-
-    // rgb(a) field
-    std::size_t red = max_size, green = max_size, blue = max_size, alpha = max_size;
-    it = std::find(fields.begin(), fields.end(), "red");
-    if (it != fields.end())
-        red = std::distance(fields.begin(), it);
-
-    it = std::find(fields.begin(), fields.end(), "green");
-    if (it != fields.end())
-        green = std::distance(fields.begin(), it);
-
-    it = std::find(fields.begin(), fields.end(), "blue");
-    if (it != fields.end())
-        blue = std::distance(fields.begin(), it);
-
-    it = std::find(fields.begin(), fields.end(), "alpha");
-    if (it != fields.end())
-        alpha = std::distance(fields.begin(), it);
-
-    // transfer the data
     bool hasData = (x != max_size && y != max_size && z != max_size);
     bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
     bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (red != max_size && green != max_size && blue != max_size);
+    bool hasColor = (red != max_size && green != max_size && blue != max_size &&
+                     (types[red] == "uchar" || types[red] == "float"));
 
+    // the fields are decoded straight into the points and their properties
+    FieldDecoder data(fields.size());
     if (hasData) {
-        points.reserve(numPoints);
-        for (std::size_t i=0; i<numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i,x),data(i,y),data(i,z)));
+        std::vector<Base::Vector3f>& pts = points.getBasicPoints();
+        std::size_t first = pts.size();
+        pts.resize(first + numPoints);
+        data.points = pts.data() + first;
+        data.targets[x] = FieldDecoder::PointX;
+        data.targets[y] = FieldDecoder::PointY;
+        data.targets[z] = FieldDecoder::PointZ;
+
+        if (hasNormal) {
+            normals.resize(numPoints);
+            data.normals = normals.data();
+            data.targets[normal_x] = FieldDecoder::NormalX;
+            data.targets[normal_y] = FieldDecoder::NormalY;
+            data.targets[normal_z] = FieldDecoder::NormalZ;
         }
-    }
 
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (std::size_t i=0; i<numPoints; i++) {
-            normals.emplace_back(data(i,normal_x),data(i,normal_y),data(i,normal_z));
+        if (hasIntensity) {
+            intensity.resize(numPoints);
+            data.intensity = intensity.data();
+            data.targets[greyvalue] = FieldDecoder::Intensity;
         }
-    }
 
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (std::size_t i=0; i<numPoints; i++) {
-            intensity.push_back(data(i,greyvalue));
+        if (hasColor) {
+            if (types[red] == "uchar")
+                data.colorScale = 1.0f/255.0f;
+            // without alpha field the alpha value is 1 before scaling
+            colors.resize(numPoints, App::Color(0.0f, 0.0f, 0.0f, data.colorScale));
+            data.colors = colors.data();
+            data.targets[red] = FieldDecoder::Red;
+            data.targets[green] = FieldDecoder::Green;
+            data.targets[blue] = FieldDecoder::Blue;
+            if (alpha != max_size)
+                data.targets[alpha] = FieldDecoder::Alpha;
         }
     }
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        float a = 1.0;
-        if (types[red] == "uchar") {
-            for (std::size_t i=0; i<numPoints; i++) {
-                float r = data(i, red);
-                float g = data(i, green);
-                float b = data(i, blue);
-                if (alpha != max_size)
-                    a = data(i, alpha);
-                colors.emplace_back(static_cast<float>(r)/255.0f,
-                                            static_cast<float>(g)/255.0f,
-                                            static_cast<float>(b)/255.0f,
-                                            static_cast<float>(a)/255.0f);
-            }
-        }
-        else if (types[red] == "float") {
-            for (std::size_t i=0; i<numPoints; i++) {
-                float r = data(i, red);
-                float g = data(i, green);
-                float b = data(i, blue);
-                if (alpha != max_size)
-                    a = data(i, alpha);
-                colors.emplace_back(r, g, b, a);
-            }
-        }
+    if (format == "ascii") {
+        readAscii(inp, offset, numPoints, data);
+    }
+    else if (format == "binary_little_endian") {
+        readBinary(false, inp, offset, numPoints, types, sizes, data);
+    }
+    else if (format == "binary_big_endian") {
+        readBinary(true, inp, offset, numPoints, types, sizes, data);
     }
 }
 
@@ -821,13 +919,11 @@ std::size_t PlyReader::readHeader(std::istream& in,
     return numPoints;
 }
 
-void PlyReader::readAscii(std::istream& inp, std::size_t offset, Eigen::MatrixXd& data)
+void PlyReader::readAscii(std::istream& inp, std::size_t offset, std::size_t numPoints,
+                          FieldDecoder& data)
 {
     std::string line;
     std::size_t row = 0;
-    std::size_t numPoints = data.rows();
-    std::size_t numFields = data.cols();
-    std::vector<std::string> list;
     while (std::getline(inp, line) && row < numPoints) {
         if (line.empty())
             continue;
@@ -837,30 +933,20 @@ void PlyReader::readAscii(std::istream& inp, std::size_t offset, Eigen::MatrixXd
             continue;
         }
 
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of ("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        for (std::size_t col = 0; col < list.size() && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
+        if (parseAsciiRow(line, row, data))
+            ++row;
     }
 }
 
 void PlyReader::readBinary(bool swapByteOrder,
                            std::istream& inp,
                            std::size_t offset,
+                           std::size_t numPoints,
                            const std::vector<std::string>& types,
                            const std::vector<int>& sizes,
-                           Eigen::MatrixXd& data)
+                           FieldDecoder& data)
 {
-    std::size_t numPoints = data.rows();
-    std::size_t numFields = data.cols();
+    std::size_t numFields = data.numFields();
 
     int neededSize = 0;
     ConverterPtr convert_float32(new ConverterT<float>);
@@ -926,14 +1012,12 @@ void PlyReader::readBinary(bool swapByteOrder,
             throw Base::BadFormatError("File expects too many elements");
     }
 
-    Base::InputStream str(inp);
-    str.setByteOrder(swapByteOrder ? Base::Stream::BigEndian : Base::Stream::LittleEndian);
-    for (std::size_t i=0; i<numPoints; i++) {
+    readBinaryBlocks(inp, numPoints, neededSize, [&](std::size_t i, const char* ptr) {
         for (std::size_t j=0; j<numFields; j++) {
-            double value = converters[j]->toDouble(str);
-            data(i, j) = value;
+            data.set(i, j, converters[j]->toDouble(ptr, swapByteOrder));
+            ptr += converters[j]->getSizeOf();
         }
-    }
+    });
 }
 
 // ----------------------------------------------------------------------------
@@ -961,12 +1045,60 @@ void PcdReader::read(const std::string& filename)
     std::vector<int> sizes;
     std::size_t numPoints = readHeader(inp, format, fields, types, sizes);
 
-    Eigen::MatrixXd data(numPoints, fields.size());
+    std::size_t max_size = std::numeric_limits<std::size_t>::max();
+    std::size_t x = findField(fields, "x");
+    std::size_t y = findField(fields, "y");
+    std::size_t z = findField(fields, "z");
+    std::size_t normal_x = findField(fields, "normal_x", "nx");
+    std::size_t normal_y = findField(fields, "normal_y", "ny");
+    std::size_t normal_z = findField(fields, "normal_z", "nz");
+    std::size_t greyvalue = findField(fields, "intensity");
+    std::size_t rgba = findField(fields, "rgb", "rgba");
+
+    bool hasData = (x != max_size && y != max_size && z != max_size);
+    bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
+    bool hasIntensity = (greyvalue != max_size);
+    bool hasColor = (rgba != max_size && (types[rgba] == "U" || types[rgba] == "F"));
+
+    // the fields are decoded straight into the points and their properties
+    FieldDecoder data(fields.size());
+    if (hasData) {
+        std::vector<Base::Vector3f>& pts = points.getBasicPoints();
+        std::size_t first = pts.size();
+        pts.resize(first + numPoints);
+        data.points = pts.data() + first;
+        data.targets[x] = FieldDecoder::PointX;
+        data.targets[y] = FieldDecoder::PointY;
+        data.targets[z] = FieldDecoder::PointZ;
+
+        if (hasNormal) {
+            normals.resize(numPoints);
+            data.normals = normals.data();
+            data.targets[normal_x] = FieldDecoder::NormalX;
+            data.targets[normal_y] = FieldDecoder::NormalY;
+            data.targets[normal_z] = FieldDecoder::NormalZ;
+        }
+
+        if (hasIntensity) {
+            intensity.resize(numPoints);
+            data.intensity = intensity.data();
+            data.targets[greyvalue] = FieldDecoder::Intensity;
+        }
+
+        // the color channels are packed into one 32 bit field
+        if (hasColor) {
+            colors.resize(numPoints);
+            data.colors = colors.data();
+            data.targets[rgba] = types[rgba] == "U" ? FieldDecoder::PackedUInt
+                                                    : FieldDecoder::PackedFloat;
+        }
+    }
+
     if (format == "ascii") {
-        readAscii(inp, data);
+        readAscii(inp, numPoints, data);
     }
     else if (format == "binary") {
-        readBinary(false, inp, types, sizes, data);
+        readBinary(false, inp, numPoints, types, sizes, data);
     }
     else if (format == "binary_compressed") {
         unsigned int c, u;
@@ -980,135 +1112,12 @@ void PcdReader::read(const std::string& filename)
             DataStreambuf ibuf(uncompressed);
             std::istream istr(0);
             istr.rdbuf(&ibuf);
-            readBinary(true, istr, types, sizes, data);
+            readBinary(true, istr, numPoints, types, sizes, data);
         }
         else {
             throw Base::BadFormatError("Failed to decompress binary data");
         }
     }
-
-    std::vector<std::string>::iterator it;
-    std::size_t max_size = std::numeric_limits<std::size_t>::max();
-
-    // x field
-    std::size_t x = max_size;
-    it = std::find(fields.begin(), fields.end(), "x");
-    if (it != fields.end())
-        x = std::distance(fields.begin(), it);
-
-    // y field
-    std::size_t y = max_size;
-    it = std::find(fields.begin(), fields.end(), "y");
-    if (it != fields.end())
-        y = std::distance(fields.begin(), it);
-
-    // z field
-    std::size_t z = max_size;
-    it = std::find(fields.begin(), fields.end(), "z");
-    if (it != fields.end())
-        z = std::distance(fields.begin(), it);
-
-    // normal x field
-    std::size_t normal_x = max_size;
-    it = std::find(fields.begin(), fields.end(), "normal_x");
-    if (it == fields.end())
-        it = std::find(fields.begin(), fields.end(), "nx");
-    if (it != fields.end())
-        normal_x = std::distance(fields.begin(), it);
-
-    // normal y field
-    std::size_t normal_y = max_size;
-    it = std::find(fields.begin(), fields.end(), "normal_y");
-    if (it == fields.end())
-        it = std::find(fields.begin(), fields.end(), "ny");
-    if (it != fields.end())
-        normal_y = std::distance(fields.begin(), it);
-
-    // normal z field
-    std::size_t normal_z = max_size;
-    it = std::find(fields.begin(), fields.end(), "normal_z");
-    if (it == fields.end())
-        it = std::find(fields.begin(), fields.end(), "nz");
-    if (it != fields.end())
-        normal_z = std::distance(fields.begin(), it);
-
-    // intensity field
-    std::size_t greyvalue = max_size;
-    it = std::find(fields.begin(), fields.end(), "intensity");
-    if (it != fields.end())
-        greyvalue = std::distance(fields.begin(), it);
-
-    // rgb(a) field
-    std::size_t rgba = max_size;
-    it = std::find(fields.begin(), fields.end(), "rgb");
-    if (it == fields.end())
-        it = std::find(fields.begin(), fields.end(), "rgba");
-    if (it != fields.end())
-        rgba = std::distance(fields.begin(), it);
-
-    // transfer the data
-    bool hasData = (x != max_size && y != max_size && z != max_size);
-    bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
-    bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (rgba != max_size);
-
-    if (hasData) {
-        points.reserve(numPoints);
-        for (std::size_t i=0; i<numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i,x),data(i,y),data(i,z)));
-        }
-    }
-
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (std::size_t i=0; i<numPoints; i++) {
-            normals.emplace_back(data(i,normal_x),data(i,normal_y),data(i,normal_z));
-        }
-    }
-
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (std::size_t i=0; i<numPoints; i++) {
-            intensity.push_back(data(i,greyvalue));
-        }
-    }
-
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        if (types[rgba] == "U") {
-            for (std::size_t i=0; i<numPoints; i++) {
-                uint32_t packed = static_cast<uint32_t>(data(i,rgba));
-                uint32_t a = (packed >> 24) & 0xff;
-                uint32_t r = (packed >> 16) & 0xff;
-                uint32_t g = (packed >> 8) & 0xff;
-                uint32_t b = packed & 0xff;
-                colors.emplace_back(static_cast<float>(r)/255.0f,
-                                            static_cast<float>(g)/255.0f,
-                                            static_cast<float>(b)/255.0f,
-                                            static_cast<float>(a)/255.0f);
-            }
-        }
-        else if (types[rgba] == "F") {
-            union RGBA {
-                uint32_t u;
-                float f;
-            };
-
-            union RGBA v;
-            for (std::size_t i=0; i<numPoints; i++) {
-                v.f = static_cast<float>(data(i,rgba));
-                uint32_t packed = v.u;
-                uint32_t a = (packed >> 24) & 0xff;
-                uint32_t r = (packed >> 16) & 0xff;
-                uint32_t g = (packed >> 8) & 0xff;
-                uint32_t b = packed & 0xff;
-                colors.emplace_back(static_cast<float>(r)/255.0f,
-                                            static_cast<float>(g)/255.0f,
-                                            static_cast<float>(b)/255.0f,
-                                            static_cast<float>(a)/255.0f);
-            }
-        }
-    }
 }
 
 std::size_t PcdReader::readHeader(std::istream& in,
@@ -1183,40 +1192,27 @@ std::size_t PcdReader::readHeader(std::istream& in,
     return points;
 }
 
-void PcdReader::readAscii(std::istream& inp, Eigen::MatrixXd& data)
+void PcdReader::readAscii(std::istream& inp, std::size_t numPoints, FieldDecoder& data)
 {
     std::string line;
     std::size_t row = 0;
-    std::size_t numPoints = data.rows();
-    std::size_t numFields = data.cols();
-    std::vector<std::string> list;
     while (std::getline(inp, line) && row < numPoints) {
         if (line.empty())
             continue;
 
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of ("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        for (std::size_t col = 0; col < list.size() && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
+        if (parseAsciiRow(line, row, data))
+            ++row;
     }
 }
 
 void PcdReader::readBinary(bool transpose,
                            std::istream& inp,
+                           std::size_t numPoints,
                            const std::vector<std::string>& types,
                            const std::vector<int>& sizes,
-                           Eigen::MatrixXd& data)
+                           FieldDecoder& data)
 {
-    std::size_t numPoints = data.rows();
-    std::size_t numFields = data.cols();
+    std::size_t numFields = data.numFields();
 
     int neededSize = 0;
     ConverterPtr convert_float32(new ConverterT<float>);
@@ -1282,22 +1278,21 @@ void PcdReader::readBinary(bool transpose,
             throw Base::BadFormatError("File expects too many elements");
     }
 
-    Base::InputStream str(inp);
     if (transpose) {
         for (std::size_t j=0; j<numFields; j++) {
-            for (std::size_t i=0; i<numPoints; i++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
+            const Converter* convert = converters[j].get();
+            readBinaryBlocks(inp, numPoints, convert->getSizeOf(), [&](std::size_t i, const char* ptr) {
+                data.set(i, j, convert->toDouble(ptr, false));
+            });
         }
     }
     else {
-        for (std::size_t i=0; i<numPoints; i++) {
+        readBinaryBlocks(inp, numPoints, neededSize, [&](std::size_t i, const char* ptr) {
             for (std::size_t j=0; j<numFields; j++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
+                data.set(i, j, converters[j]->toDouble(ptr, false));
+                ptr += converters[j]->getSizeOf();
             }
-        }
+        });
     }
 }
 
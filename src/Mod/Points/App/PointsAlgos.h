@@ -33,6 +33,8 @@ namespace Points
 
 /** The Points algorithms container class
  */
+class FieldDecoder;
+
 class PointsExport PointsAlgos
 {
 public:
@@ -91,11 +93,13 @@ private:
     std::size_t readHeader(std::istream&, std::string& format, std::size_t& offset,
         std::vector<std::string>& fields, std::vector<std::string>& types,
         std::vector<int>& sizes);
-    void readAscii(std::istream&, std::size_t offset, Eigen::MatrixXd& data);
+    void readAscii(std::istream&, std::size_t offset, std::size_t numPoints,
+        FieldDecoder& data);
     void readBinary(bool swapByteOrder, std::istream&, std::size_t offset,
+        std::size_t numPoints,
         const std::vector<std::string>& types,
         const std::vector<int>& sizes,
-        Eigen::MatrixXd& data);
+        FieldDecoder& data);
 };
 
 class PcdReader : public Reader
@@ -108,11 +112,11 @@ public:
 private:
     std::size_t readHeader(std::istream&, std::string& format, std::vector<std::string>& fields,
         std::vector<std::string>& types, std::vector<int>& sizes);
-    void readAscii(std::istream&, Eigen::MatrixXd& data);
-    void readBinary(bool transpose, std::istream&,
+    void readAscii(std::istream&, std::size_t numPoints, FieldDecoder& data);
+    void readBinary(bool transpose, std::istream&, std::size_t numPoints,
         const std::vector<std::string>& types,
         const std::vector<int>& sizes,
-        Eigen::MatrixXd& data);
+        FieldDecoder& data);
 };
 
 class Writer
@@ -45,6 +45,7 @@
 // standard
 #include <stdio.h>
 #include <assert.h>
+#include <cstring>
 
 // STL
 #include <algorithm>
@@ -48,6 +48,7 @@
 #include "DrawTemplate.h"
 #include "DrawViewCollection.h"
 #include "DrawViewPart.h"
+#include "GeometryObject.h"
 #include "DrawViewDimension.h"
 #include "DrawViewBalloon.h"
 #include "DrawLeaderLine.h"
@@ -106,6 +107,8 @@ DrawPage::DrawPage(void)
 
 DrawPage::~DrawPage()
 {
+    //cached projections hold on to the source shapes
+    GeometryObject::clearProjectionCache(this);
 }
 
 void DrawPage::onBeforeChange(const App::Property* prop)
@@ -344,8 +347,19 @@ void DrawPage::updateAllViews()
 //    Base::Console().Message("DP::updateAllViews()\n");
     std::vector<App::DocumentObject*> featViews = getAllViews();
     std::vector<App::DocumentObject*>::iterator it = featViews.begin();
+    //project the independent Parts concurrently, their recompute below uses the results
+    if (Preferences::concurrentViews() && !Preferences::draftProjection()) {
+        std::vector<TechDraw::DrawViewPart*> parts;
+        for(; it != featViews.end(); ++it) {
+            TechDraw::DrawViewPart *part = dynamic_cast<TechDraw::DrawViewPart *>(*it);
+            if (part != nullptr) {
+                parts.push_back(part);
+            }
+        }
+        TechDraw::DrawViewPart::prefetchProjections(parts);
+    }
     //first, make sure all the Parts have been executed so GeometryObjects exist
-    for(; it != featViews.end(); ++it) {
+    for(it = featViews.begin(); it != featViews.end(); ++it) {
         TechDraw::DrawViewPart *part = dynamic_cast<TechDraw::DrawViewPart *>(*it);
         TechDraw::DrawViewCollection *collect = dynamic_cast<TechDraw::DrawViewCollection*>(*it);
         if (part != nullptr) {
@@ -62,6 +62,12 @@
 
 #endif
 
+#include <Bnd_BoundSortBox.hxx>
+#include <Bnd_HArray1OfBox.hxx>
+#include <TColStd_ListIteratorOfListOfInteger.hxx>
+
+#include <QtConcurrentMap>
+
 #include <limits>
 #include <algorithm>
 #include <cmath>
@@ -170,63 +176,7 @@ std::vector<TopoDS_Edge> DrawProjectSplit::getEdges(TechDraw::GeometryObject* ge
 
     //HLR algo does not provide all edge intersections for edge endpoints.
     //need to split long edges touched by Vertex of another edge
-    std::vector<splitPoint> splits;
-    std::vector<TopoDS_Edge>::iterator itOuter = origEdges.begin();
-    int iOuter = 0;
-    for (; itOuter != origEdges.end(); ++itOuter, iOuter++) {
-        TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
-        TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::Add(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
-            Base::Console().Message("DPS::Extract Faces - outer Bnd_Box is void\n");
-            continue;
-        }
-        if (DrawUtil::isZeroEdge(*itOuter)) {
-            Base::Console().Message("DPS::extractFaces - outerEdge: %d is ZeroEdge\n",iOuter);   //this is not finding ZeroEdges
-            continue;  //skip zero length edges. shouldn't happen ;)
-        }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = faceEdges.begin();
-        for (; itInner != faceEdges.end(); ++itInner,iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
-                continue;  //skip zero length edges. shouldn't happen ;)
-            }
-
-            Bnd_Box sInner;
-            BRepBndLib::Add(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
-                Base::Console().Log("INFO - DPS::Extract Faces - inner Bnd_Box is void\n");
-                continue;
-            }
-            if (sOuter.IsOut(sInner)) {      //bboxes of edges don't intersect, don't bother
-                continue;
-            }
-
-            double param = -1;
-            if (isOnEdge((*itInner),v1,param,false)) {
-                gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
-                splitPoint s1;
-                s1.i = iInner;
-                s1.v = Base::Vector3d(pnt1.X(),pnt1.Y(),pnt1.Z());
-                s1.param = param;
-                splits.push_back(s1);
-            }
-            if (isOnEdge((*itInner),v2,param,false)) {
-                gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
-                splitPoint s2;
-                s2.i = iInner;
-                s2.v = Base::Vector3d(pnt2.X(),pnt2.Y(),pnt2.Z());
-                s2.param = param;
-                splits.push_back(s2);
-            }
-        } //inner loop
-    }   //outer loop
+    std::vector<splitPoint> splits = findSplitPoints(origEdges);
 
     std::vector<splitPoint> sorted = sortSplits(splits,true);
     auto last = std::unique(sorted.begin(), sorted.end(), DrawProjectSplit::splitEqual);  //duplicates to back
@@ -244,15 +194,22 @@ std::vector<TopoDS_Edge> DrawProjectSplit::getEdges(TechDraw::GeometryObject* ge
 //this routine is the big time consumer.  gets called many times (and is slow?))
 //note param gets modified here
 bool DrawProjectSplit::isOnEdge(TopoDS_Edge e, TopoDS_Vertex v, double& param, bool allowEnds)
+{
+    Bnd_Box sBox;
+    BRepBndLib::Add(e, sBox);
+    sBox.SetGap(0.1);
+    return isOnEdge(e, sBox, v, param, allowEnds);
+}
+
+//! same as above, for callers that already know the bounding box of e
+bool DrawProjectSplit::isOnEdge(const TopoDS_Edge& e, const Bnd_Box& sBox, const TopoDS_Vertex& v,
+                                double& param, bool allowEnds)
 {
     bool result = false;
     bool outOfBox = false;
     param = -2;
 
     //eliminate obvious cases
-    Bnd_Box sBox;
-    BRepBndLib::Add(e, sBox);
-    sBox.SetGap(0.1);
     if (sBox.IsVoid()) {
         Base::Console().Message("DPS::isOnEdge - Bnd_Box is void\n");
     } else {
@@ -289,6 +246,100 @@ bool DrawProjectSplit::isOnEdge(TopoDS_Edge e, TopoDS_Vertex v, double& param, b
 }
 
 
+//! find the points where a vertex of an edge touches another edge between its ends.
+//! the bounding boxes of the edges are computed once and kept in a grid, so only
+//! edges with overlapping boxes are tested against each other.
+std::vector<splitPoint> DrawProjectSplit::findSplitPoints(const std::vector<TopoDS_Edge>& edges)
+{
+    std::vector<splitPoint> result;
+    int count = edges.size();
+    if (count < 2) {
+        return result;
+    }
+
+    Handle(Bnd_HArray1OfBox) boxes = new Bnd_HArray1OfBox(1, count);
+    Bnd_Box enclosing;
+    std::vector<bool> valid(count, false);
+    for (int i = 0; i < count; i++) {
+        Bnd_Box box;
+        BRepBndLib::Add(edges[i], box);
+        box.SetGap(0.1);
+        if (box.IsVoid()) {
+            Base::Console().Log("DPS::findSplitPoints - Bnd_Box is void for edge %d\n", i);
+        } else if (DrawUtil::isZeroEdge(edges[i])) {
+            Base::Console().Log("DPS::findSplitPoints - edge %d is ZeroEdge\n", i);   //skip zero length edges. shouldn't happen ;)
+        } else {
+            valid[i] = true;
+            enclosing.Add(box);
+            boxes->SetValue(i + 1, box);
+        }
+    }
+    if (enclosing.IsVoid()) {
+        return result;
+    }
+
+    Bnd_BoundSortBox grid;
+    grid.Initialize(enclosing, boxes);
+
+    //pairs of edges with touching bboxes, ordered by outer then inner edge
+    std::vector<std::pair<int, int> > pairs;
+    std::vector<int> inner;
+    for (int iOuter = 0; iOuter < count; iOuter++) {
+        if (!valid[iOuter]) {
+            continue;
+        }
+        inner.clear();
+        const TColStd_ListOfInteger& hits = grid.Compare(boxes->Value(iOuter + 1));
+        for (TColStd_ListIteratorOfListOfInteger it(hits); it.More(); it.Next()) {
+            int iInner = it.Value() - 1;
+            if (iInner != iOuter && valid[iInner]) {
+                inner.push_back(iInner);
+            }
+        }
+        std::sort(inner.begin(), inner.end());
+        inner.erase(std::unique(inner.begin(), inner.end()), inner.end());
+        for (int iInner : inner) {
+            pairs.emplace_back(iOuter, iInner);
+        }
+    }
+
+    //the vertex on edge tests are independent, run them in parallel.
+    //every pair owns two slots for the split points of its first and last vertex
+    std::vector<splitPoint> found(2 * pairs.size());
+    std::vector<char> isSplit(2 * pairs.size(), 0);
+    std::vector<std::pair<std::size_t, std::size_t> > blocks;
+    const std::size_t blockSize = 64;
+    for (std::size_t i = 0; i < pairs.size(); i += blockSize) {
+        blocks.emplace_back(i, std::min(i + blockSize, pairs.size()));
+    }
+    QtConcurrent::blockingMap(blocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+        for (std::size_t i = block.first; i < block.second; i++) {
+            const TopoDS_Edge& outer = edges[pairs[i].first];
+            const TopoDS_Edge& innerEdge = edges[pairs[i].second];
+            const Bnd_Box& innerBox = boxes->Value(pairs[i].second + 1);
+            TopoDS_Vertex verts[2] = { TopExp::FirstVertex(outer), TopExp::LastVertex(outer) };
+            for (int j = 0; j < 2; j++) {
+                double param = -1;
+                if (isOnEdge(innerEdge, innerBox, verts[j], param, false)) {
+                    gp_Pnt pnt = BRep_Tool::Pnt(verts[j]);
+                    splitPoint& s = found[2 * i + j];
+                    s.i = pairs[i].second;
+                    s.v = Base::Vector3d(pnt.X(), pnt.Y(), pnt.Z());
+                    s.param = param;
+                    isSplit[2 * i + j] = 1;
+                }
+            }
+        }
+    });
+
+    for (std::size_t i = 0; i < found.size(); i++) {
+        if (isSplit[i]) {
+            result.push_back(found[i]);
+        }
+    }
+    return result;
+}
+
 std::vector<TopoDS_Edge> DrawProjectSplit::splitEdges(std::vector<TopoDS_Edge> edges, std::vector<splitPoint> splits)
 {
     std::vector<TopoDS_Edge> result;
@@ -77,10 +77,17 @@
 
 #include <limits>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 
+#include <QCoreApplication>
+#include <QFutureWatcher>
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
+
 #include <App/Application.h>
 #include <App/Document.h>
+#include <App/DocumentObserver.h>
 #include <App/GroupExtension.h>
 #include <App/Part.h>
 #include <Base/BoundBox.h>
@@ -97,6 +104,7 @@
 #include "DrawGeomHatch.h"
 #include "DrawHatch.h"
 #include "DrawPage.h"
+#include "DrawProjGroupItem.h"
 #include "DrawProjectSplit.h"
 #include "DrawUtil.h"
 #include "DrawViewBalloon.h"
@@ -133,6 +141,7 @@ DrawViewPart::DrawViewPart(void) :
     static const char *sgroup = "HLR Parameters";
     nowUnsetting = false;
     m_handleFaces = false;
+    m_useProjectionCache = false;
 
     CosmeticExtension::initExtension(this);
 
@@ -348,19 +357,29 @@ void DrawViewPart::onChanged(const App::Property* prop)
 void DrawViewPart::partExec(TopoDS_Shape shape)
 {
 //    Base::Console().Message("DVP::partExec()\n");
+    auto start = std::chrono::high_resolution_clock::now();
     geometryObject = makeGeometryForShape(shape);
+    auto end   = std::chrono::high_resolution_clock::now();
+    double diffOut = std::chrono::duration <double, std::milli> (end - start).count();
+    Base::Console().Log("TIMING - %s DVP spent: %.3f millisecs in projection and edge extraction\n",
+                        getNameInDocument(), diffOut);
     if (geometryObject == nullptr) {
         return;
     }
 
 #if MOD_TECHDRAW_HANDLE_FACES
     if (handleFaces() && !geometryObject->usePolygonHLR()) {
+        start = std::chrono::high_resolution_clock::now();
         try {
             extractFaces();
         }
         catch (Standard_Failure& e4) {
             Base::Console().Log("LOG - DVP::partExec - extractFaces failed for %s - %s **\n",getNameInDocument(),e4.GetMessageString());
         }
+        end   = std::chrono::high_resolution_clock::now();
+        diffOut = std::chrono::duration <double, std::milli> (end - start).count();
+        Base::Console().Log("TIMING - %s DVP spent: %.3f millisecs in extractFaces\n",
+                            getNameInDocument(), diffOut);
     }
 #endif //#if MOD_TECHDRAW_HANDLE_FACES
 //    std::vector<TechDraw::Vertex*> verts = getVertexGeometry();
@@ -403,33 +422,180 @@ void DrawViewPart::addShapes2d(void)
 
 GeometryObject* DrawViewPart::makeGeometryForShape(TopoDS_Shape shape)
 {
-    gp_Pnt inputCenter;
     Base::Vector3d stdOrg(0.0,0.0,0.0);
 
     gp_Ax2 viewAxis = getProjectionCS(stdOrg);
 
-    inputCenter = TechDraw::findCentroid(shape,
-                                         viewAxis);
-    Base::Vector3d centroid(inputCenter.X(),
-                            inputCenter.Y(),
-                            inputCenter.Z());
-
-    //center shape on origin
-    TopoDS_Shape centeredShape = TechDraw::moveShape(shape,
-                                                     centroid * -1.0);
+    Base::Vector3d centroid;
+    TopoDS_Shape centeredShape;
+    TopoDS_Shape scaledShape = prepareShape(shape, viewAxis, centroid, centeredShape);
     m_saveCentroid = centroid;
     m_saveShape = centeredShape;
 
+//    BRepTools::Write(scaledShape, "DVPScaled.brep");            //debug
+    m_useProjectionCache = true;                //scaledShape is made from our sources
+    GeometryObject* go =  buildGeometryObject(scaledShape,viewAxis);
+    m_useProjectionCache = false;
+    return go;
+}
+
+//! center, scale and rotate the source shape for projection
+TopoDS_Shape DrawViewPart::prepareShape(const TopoDS_Shape& shape,
+                                        const gp_Ax2& viewAxis,
+                                        Base::Vector3d& centroid,
+                                        TopoDS_Shape& centeredShape) const
+{
+    gp_Pnt inputCenter = TechDraw::findCentroid(shape,
+                                                viewAxis);
+    centroid = Base::Vector3d(inputCenter.X(),
+                              inputCenter.Y(),
+                              inputCenter.Z());
+
+    //center shape on origin
+    centeredShape = TechDraw::moveShape(shape,
+                                        centroid * -1.0);
+
     TopoDS_Shape scaledShape = TechDraw::scaleShape(centeredShape,
                                                     getScale());
     if (!DrawUtil::fpCompare(Rotation.getValue(),0.0)) {
+        gp_Ax2 rotAxis = viewAxis;
         scaledShape = TechDraw::rotateShape(scaledShape,
-                                            viewAxis,
+                                            rotAxis,
                                             Rotation.getValue());  //conventional rotation
      }
-//    BRepTools::Write(scaledShape, "DVPScaled.brep");            //debug
-    GeometryObject* go =  buildGeometryObject(scaledShape,viewAxis);
-    return go;
+    return scaledShape;
+}
+
+//! identify the projection of our sources in the projection cache.
+//! returns an invalid key if a source has no shape of its own.
+ProjectionKey DrawViewPart::getProjectionKey(const gp_Ax2& viewAxis) const
+{
+    ProjectionKey key;
+    for (auto& l: getAllSources()) {
+        TopoDS_Shape s = Part::Feature::getShape(l);
+        if (s.IsNull()) {
+            return ProjectionKey();
+        }
+        key.sources.push_back(s);
+    }
+    key.viewAxis = viewAxis;
+    key.scale = getScale();
+    key.rotation = Rotation.getValue();
+    key.focus = Focus.getValue();
+    key.isoCount = IsoCount.getValue();
+    key.perspective = Perspective.getValue();
+    key.polygonHLR = CoarseView.getValue();
+    return key;
+}
+
+namespace {
+    //the background projection reports back through the Gui event loop. Without
+    //it (FreeCADCmd, scripts) the exact projection has to be done right away.
+    bool hasEventLoop()
+    {
+        QCoreApplication* app = QCoreApplication::instance();
+        return app && app->inherits("QApplication");
+    }
+
+    //! messages from worker threads are delivered on the main thread while this is alive.
+    //! queued messages are posted as Qt events, so without an event loop nothing changes.
+    class QueuedConsoleGuard
+    {
+    public:
+        QueuedConsoleGuard()
+            : previous(Base::Console().GetConnectionMode())
+            , active(hasEventLoop())
+        {
+            if (active) {
+                Base::Console().SetConnectionMode(Base::ConsoleSingleton::Queued);
+            }
+        }
+        ~QueuedConsoleGuard() {
+            if (active) {
+                Base::Console().SetConnectionMode(previous);
+            }
+        }
+    private:
+        Base::ConsoleSingleton::ConnectionMode previous;
+        bool active;
+    };
+}
+
+//! the hidden line removal is the expensive part of updating a view and does not
+//! touch the document, so for a page full of views it is done here in worker threads.
+//! the shapes are prepared on the main thread and the HLR output goes to the
+//! projection cache, where the following recompute of each view picks it up.
+void DrawViewPart::prefetchProjections(const std::vector<DrawViewPart*>& views)
+{
+    struct ProjectionTask {
+        DrawViewPart* view;
+        const DrawPage* page;
+        TopoDS_Shape shape;
+        gp_Ax2 viewAxis;
+        ProjectionKey key;
+        double time;
+    };
+
+    std::vector<ProjectionTask> tasks;
+    for (auto& v: views) {
+        //sections, details etc project other shapes than their sources
+        if (v->getTypeId() != DrawViewPart::getClassTypeId() &&
+            v->getTypeId() != DrawProjGroupItem::getClassTypeId()) {
+            continue;
+        }
+        if (!v->keepUpdated() || v->getAllSources().empty()) {
+            continue;
+        }
+        ProjectionTask task;
+        task.view = v;
+        task.page = v->findParentPage();
+        task.viewAxis = v->getProjectionCS(Base::Vector3d(0.0, 0.0, 0.0));
+        task.key = v->getProjectionKey(task.viewAxis);
+        task.time = 0.0;
+        if (!task.key.isValid() || GeometryObject::hasProjection(task.key)) {
+            continue;
+        }
+        TopoDS_Shape shape = v->getSourceShape();
+        if (shape.IsNull()) {
+            continue;
+        }
+        Base::Vector3d centroid;
+        TopoDS_Shape centeredShape;
+        task.shape = v->prepareShape(shape, task.viewAxis, centroid, centeredShape);
+        tasks.push_back(task);
+    }
+    if (tasks.size() < 2) {
+        return;             //nothing to gain, the view will project itself
+    }
+
+    {
+        //messages from the worker threads are delivered on the main thread
+        QueuedConsoleGuard queued;
+        QtConcurrent::blockingMap(tasks, [](ProjectionTask& task) {
+            auto start = std::chrono::high_resolution_clock::now();
+            GeometryObject go(task.view->getNameInDocument(), task.view);
+            go.setIsoCount(task.key.isoCount);
+            go.isPerspective(task.key.perspective);
+            go.setFocus(task.key.focus);
+            go.usePolygonHLR(task.key.polygonHLR);
+            bool success;
+            if (go.usePolygonHLR()) {
+                success = go.projectShapeWithPolygonAlgo(task.shape, task.viewAxis);
+            } else {
+                success = go.projectShape(task.shape, task.viewAxis);
+            }
+            if (success) {
+                go.storeProjection(task.key, task.page);
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            task.time = std::chrono::duration <double, std::milli> (end - start).count();
+        });
+    }
+
+    for (auto& task: tasks) {
+        Base::Console().Log("TIMING - %s DVP spent: %.3f millisecs in concurrent projection\n",
+                            task.view->getNameInDocument(), task.time);
+    }
 }
 
 //note: slightly different than routine with same name in DrawProjectSplit
@@ -441,13 +607,33 @@ TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape,
     go->setFocus(Focus.getValue());
     go->usePolygonHLR(CoarseView.getValue());
 
-    if (go->usePolygonHLR()){
+    ProjectionKey key;
+    if (m_useProjectionCache) {
+        key = getProjectionKey(viewAxis);
+    }
+    const DrawPage* page = findParentPage();
+    if (go->restoreProjection(key, page)) {
+        Base::Console().Log("DVP::buildGO - %s reuses cached projection\n", getNameInDocument());
+    } else if (key.isValid() && !go->usePolygonHLR() && Preferences::draftProjection() &&
+               hasEventLoop()) {
+        //show the polygonal projection now and replace it when the exact one is ready
+        go->usePolygonHLR(true);
         go->projectShapeWithPolygonAlgo(shape,
             viewAxis);
-    }
-    else{
-        go->projectShape(shape,
-            viewAxis);
+        startExactProjection(shape, viewAxis, key);
+    } else {
+        bool success;
+        if (go->usePolygonHLR()){
+            success = go->projectShapeWithPolygonAlgo(shape,
+                viewAxis);
+        }
+        else{
+            success = go->projectShape(shape,
+                viewAxis);
+        }
+        if (success) {
+            go->storeProjection(key, page);
+        }
     }
 
     go->extractGeometry(TechDraw::ecHARD,                   //always show the hard&outline visible lines
@@ -493,6 +679,72 @@ TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape,
     return go;
 }
 
+namespace {
+    //keys of the exact projections running in the background. only used on the main thread.
+    std::vector<ProjectionKey> pendingProjections;
+}
+
+//! compute the exact projection in a worker thread. When it is done the view
+//! is recomputed and picks it up from the projection cache.
+void DrawViewPart::startExactProjection(const TopoDS_Shape& shape,
+                                        const gp_Ax2& viewAxis,
+                                        const ProjectionKey& key)
+{
+    for (auto& pending: pendingProjections) {
+        if (pending == key) {
+            return;
+        }
+    }
+    pendingProjections.push_back(key);
+
+    //not a deep copy: the draft projection only relocates the shape (moveShape), so the
+    //worker shares TShapes and face triangulations with the main thread. This is safe
+    //only because the draft projection has finished meshing before the worker starts.
+    //Do not mesh shape on the main thread after this point.
+    TopoDS_Shape exactShape = shape;
+    std::string name = getNameInDocument();
+    const DrawPage* page = findParentPage();
+    App::DocumentObjectT objT(this);
+
+    QFutureWatcher<void>* watcher = new QFutureWatcher<void>();
+    QObject::connect(watcher, &QFutureWatcher<void>::finished, [watcher, objT, key]() {
+        watcher->deleteLater();
+        for (auto it = pendingProjections.begin(); it != pendingProjections.end(); ++it) {
+            if (*it == key) {
+                pendingProjections.erase(it);
+                break;
+            }
+        }
+        DrawViewPart* view = dynamic_cast<DrawViewPart*>(objT.getObject());
+        if (view == nullptr) {
+            return;                                 //deleted while we were busy
+        }
+        gp_Ax2 viewAxis = view->getProjectionCS(Base::Vector3d(0.0, 0.0, 0.0));
+        if (!(view->getProjectionKey(viewAxis) == key)) {
+            return;                                 //changed meanwhile, a newer projection is on its way
+        }
+        if (view->getDocument()->testStatus(App::Document::Recomputing)) {
+            view->touch();
+        } else {
+            view->recomputeFeature();
+        }
+    });
+    watcher->setFuture(QtConcurrent::run([exactShape, viewAxis, key, name, page]() {
+        auto start = std::chrono::high_resolution_clock::now();
+        GeometryObject go(name, nullptr);
+        go.setIsoCount(key.isoCount);
+        go.isPerspective(key.perspective);
+        go.setFocus(key.focus);
+        if (go.projectShape(exactShape, viewAxis)) {
+            go.storeProjection(key, page);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double diffOut = std::chrono::duration <double, std::milli> (end - start).count();
+        Base::Console().Log("TIMING - %s DVP spent: %.3f millisecs in background exact projection\n",
+                            name.c_str(), diffOut);
+    }));
+}
+
 //! make faces from the existing edge geometry
 void DrawViewPart::extractFaces()
 {
@@ -520,63 +772,7 @@ void DrawViewPart::extractFaces()
 
     //HLR algo does not provide all edge intersections for edge endpoints.
     //need to split long edges touched by Vertex of another edge
-    std::vector<splitPoint> splits;
-    std::vector<TopoDS_Edge>::iterator itOuter = nonZero.begin();
-    int iOuter = 0;
-    for (; itOuter != nonZero.end(); ++itOuter, iOuter++) {    //*** itOuter != nonZero.end() - 1
-        TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
-        TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::Add(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
-            Base::Console().Log("DVP::Extract Faces - outer Bnd_Box is void for %s\n",getNameInDocument());
-            continue;
-        }
-        if (DrawUtil::isZeroEdge(*itOuter)) {
-            Base::Console().Log("DVP::extractFaces - outerEdge: %d is ZeroEdge\n",iOuter);   //this is not finding ZeroEdges
-            continue;  //skip zero length edges. shouldn't happen ;)
-        }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = nonZero.begin();   //***sb itOuter + 1;
-        for (; itInner != nonZero.end(); ++itInner,iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
-                continue;  //skip zero length edges. shouldn't happen ;)
-            }
-
-            Bnd_Box sInner;
-            BRepBndLib::Add(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
-                Base::Console().Log("INFO - DVP::Extract Faces - inner Bnd_Box is void for %s\n",getNameInDocument());
-                continue;
-            }
-            if (sOuter.IsOut(sInner)) {      //bboxes of edges don't intersect, don't bother
-                continue;
-            }
-
-            double param = -1;
-            if (DrawProjectSplit::isOnEdge((*itInner),v1,param,false)) {
-                gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
-                splitPoint s1;
-                s1.i = iInner;
-                s1.v = Base::Vector3d(pnt1.X(),pnt1.Y(),pnt1.Z());
-                s1.param = param;
-                splits.push_back(s1);
-            }
-            if (DrawProjectSplit::isOnEdge((*itInner),v2,param,false)) {
-                gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
-                splitPoint s2;
-                s2.i = iInner;
-                s2.v = Base::Vector3d(pnt2.X(),pnt2.Y(),pnt2.Z());
-                s2.param = param;
-                splits.push_back(s2);
-            }
-        } //inner loop
-    }   //outer loop
+    std::vector<splitPoint> splits = DrawProjectSplit::findSplitPoints(nonZero);
 
     std::vector<splitPoint> sorted = DrawProjectSplit::sortSplits(splits,true);
     auto last = std::unique(sorted.begin(), sorted.end(), DrawProjectSplit::splitEqual);  //duplicates to back
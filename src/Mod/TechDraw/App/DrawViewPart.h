@@ -60,6 +60,7 @@ class Part;
 namespace TechDraw
 {
 class GeometryObject;
+class ProjectionKey;
 class Vertex;
 class BaseGeom;
 class Face;
@@ -205,6 +206,9 @@ public:
 
     std::vector<App::DocumentObject*> getAllSources(void) const;
 
+    //! run the hidden line removal of several views in worker threads
+    static void prefetchProjections(const std::vector<DrawViewPart*>& views);
+
 
 protected:
     bool checkXDirection(void) const;
@@ -217,6 +221,14 @@ protected:
 
     virtual TechDraw::GeometryObject*  buildGeometryObject(TopoDS_Shape shape, gp_Ax2 viewAxis); //const??
     virtual TechDraw::GeometryObject*  makeGeometryForShape(TopoDS_Shape shape);   //const??
+    TopoDS_Shape prepareShape(const TopoDS_Shape& shape,
+                              const gp_Ax2& viewAxis,
+                              Base::Vector3d& centroid,
+                              TopoDS_Shape& centeredShape) const;
+    TechDraw::ProjectionKey getProjectionKey(const gp_Ax2& viewAxis) const;
+    void startExactProjection(const TopoDS_Shape& shape,
+                              const gp_Ax2& viewAxis,
+                              const TechDraw::ProjectionKey& key);
     void partExec(TopoDS_Shape shape);
     virtual void addShapes2d(void);
 
@@ -246,6 +258,7 @@ protected:
 
 private:
     bool nowUnsetting;
+    bool m_useProjectionCache;   //only set while makeGeometryForShape projects the source shape
 
 };
 
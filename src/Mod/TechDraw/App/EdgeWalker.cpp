@@ -45,6 +45,8 @@
 #endif
 #include <sstream>
 #include <cmath>
+#include <unordered_map>
+#include <algorithm>
 
 #include <Base/Console.h>
 #include <Base/Exception.h>
@@ -102,6 +104,79 @@ void edgeVisitor::setGraph(TechDraw::graph& g)
 //separated by more than 2*Precision::Confusion (expected tolerance for 2 TopoDS_Vertex)
 #define EWTOLERANCE 0.00001    //arbitrary number that seems to give good results for drawing
 
+namespace {
+
+//! uniform grid of vertex positions with cell size equal to the tolerance, so
+//! a point can only match vertices in its own or the neighbouring cells.
+class VertexGrid
+{
+public:
+    explicit VertexGrid(double tolerance) : tol(tolerance) {}
+
+    void add(const TopoDS_Vertex& v)
+    {
+        gp_Pnt p = BRep_Tool::Pnt(v);
+        cells[cellOf(p)].push_back(static_cast<int>(points.size()));
+        points.push_back(p);
+    }
+
+    //! indices of all stored vertices within tolerance of v, in insertion order
+    std::vector<int> findNear(const TopoDS_Vertex& v) const
+    {
+        std::vector<int> result;
+        gp_Pnt p = BRep_Tool::Pnt(v);
+        Cell c = cellOf(p);
+        for (long long i = c.x - 1; i <= c.x + 1; i++) {
+            for (long long j = c.y - 1; j <= c.y + 1; j++) {
+                for (long long k = c.z - 1; k <= c.z + 1; k++) {
+                    auto it = cells.find(Cell{i, j, k});
+                    if (it == cells.end()) {
+                        continue;
+                    }
+                    for (int idx : it->second) {
+                        if (points[idx].IsEqual(p, tol)) {
+                            result.push_back(idx);
+                        }
+                    }
+                }
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+private:
+    struct Cell {
+        long long x, y, z;
+        bool operator==(const Cell& other) const
+        {
+            return x == other.x && y == other.y && z == other.z;
+        }
+    };
+    struct CellHash {
+        std::size_t operator()(const Cell& c) const
+        {
+            std::size_t h = std::hash<long long>()(c.x);
+            h = h * 31 + std::hash<long long>()(c.y);
+            h = h * 31 + std::hash<long long>()(c.z);
+            return h;
+        }
+    };
+
+    Cell cellOf(const gp_Pnt& p) const
+    {
+        return Cell{static_cast<long long>(std::floor(p.X() / tol)),
+                    static_cast<long long>(std::floor(p.Y() / tol)),
+                    static_cast<long long>(std::floor(p.Z() / tol))};
+    }
+
+    double tol;
+    std::vector<gp_Pnt> points;
+    std::unordered_map<Cell, std::vector<int>, CellHash> cells;
+};
+
+}
+
 
 EdgeWalker::EdgeWalker()
 {
@@ -309,21 +384,20 @@ std::vector<TopoDS_Vertex> EdgeWalker:: makeUniqueVList(std::vector<TopoDS_Edge>
 {
     //Base::Console().Message("TRACE - EW::makeUniqueVList()\n");
     std::vector<TopoDS_Vertex> uniqueVert;
+    VertexGrid grid(EWTOLERANCE);
     for(auto& e:edges) {
         TopoDS_Vertex v1 = TopExp::FirstVertex(e);
         TopoDS_Vertex v2 = TopExp::LastVertex(e);
-        bool addv1 = true;
-        bool addv2 = true;
-        for (auto v:uniqueVert) {
-            if (DrawUtil::isSamePoint(v,v1,EWTOLERANCE))
-                addv1 = false;
-            if (DrawUtil::isSamePoint(v,v2,EWTOLERANCE))
-                addv2 = false;
-        }
-        if (addv1)
+        bool addv1 = grid.findNear(v1).empty();
+        bool addv2 = grid.findNear(v2).empty();
+        if (addv1) {
             uniqueVert.push_back(v1);
-        if (addv2)
+            grid.add(v1);
+        }
+        if (addv2) {
             uniqueVert.push_back(v2);
+            grid.add(v2);
+        }
     }
     return uniqueVert;
 }
@@ -334,12 +408,18 @@ std::vector<WalkerEdge> EdgeWalker::makeWalkerEdges(std::vector<TopoDS_Edge> edg
 {
 //    Base::Console().Message("TRACE - EW::makeWalkerEdges()\n");
     m_saveInEdges = edges;
+    VertexGrid grid(EWTOLERANCE);
+    for (auto& v: verts) {
+        grid.add(v);
+    }
     std::vector<WalkerEdge> walkerEdges;
     for (auto e:edges) {
         TopoDS_Vertex ev1 = TopExp::FirstVertex(e);
         TopoDS_Vertex ev2 = TopExp::LastVertex(e);
-        int v1dx = findUniqueVert(ev1, verts);
-        int v2dx = findUniqueVert(ev2, verts);
+        std::vector<int> first = grid.findNear(ev1);             //same as findUniqueVert: first match
+        std::vector<int> last = grid.findNear(ev2);
+        int v1dx = first.empty() ? 0 : first.front();
+        int v2dx = last.empty() ? 0 : last.front();
         WalkerEdge we;
         we.v1 = v1dx;
         we.v2 = v2dx;
@@ -413,25 +493,30 @@ std::vector<embedItem> EdgeWalker::makeEmbedding(const std::vector<TopoDS_Edge>
 //                            edges.size(),uniqueVList.size());
     std::vector<embedItem> result;
 
-    int iv = 0;
+    VertexGrid grid(EWTOLERANCE);
     for (auto& v: uniqueVList) {
-        int ie = 0;
-        std::vector<incidenceItem> iiList;
-        for (auto& e: edges) {
-            double angle = 0;
-            if (DrawUtil::isFirstVert(e,v,EWTOLERANCE)) {
-                angle = DrawUtil::angleWithX(e,v,EWTOLERANCE);
-                incidenceItem ii(ie, angle, m_saveWalkerEdges[ie].ed);
-                iiList.push_back(ii);
-            } else if (DrawUtil::isLastVert(e,v,EWTOLERANCE)) {
-                angle = DrawUtil::angleWithX(e,v,EWTOLERANCE);
-                incidenceItem ii(ie, angle, m_saveWalkerEdges[ie].ed);
-                iiList.push_back(ii);
-            } else {
-                //Base::Console().Message("TRACE - EW::makeEmbedding - neither first nor last\n");
-            }
-            ie++;
-       }
+        grid.add(v);
+    }
+
+    //visit the edges in order so every incidence list is built in edge order
+    std::vector<std::vector<incidenceItem> > iiLists(uniqueVList.size());
+    int ie = 0;
+    for (auto& e: edges) {
+        std::vector<int> found = grid.findNear(TopExp::FirstVertex(e));
+        std::vector<int> atLast = grid.findNear(TopExp::LastVertex(e));
+        found.insert(found.end(), atLast.begin(), atLast.end());
+        std::sort(found.begin(), found.end());
+        found.erase(std::unique(found.begin(), found.end()), found.end());
+        for (int iv: found) {
+            double angle = DrawUtil::angleWithX(e,uniqueVList[iv],EWTOLERANCE);
+            incidenceItem ii(ie, angle, m_saveWalkerEdges[ie].ed);
+            iiLists[iv].push_back(ii);
+        }
+        ie++;
+    }
+
+    int iv = 0;
+    for (auto& iiList: iiLists) {
        //sort incidenceList by angle
        iiList = embedItem::sortIncidenceList(iiList,  false);
        embedItem embed(iv, iiList);
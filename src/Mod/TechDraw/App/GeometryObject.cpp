@@ -68,6 +68,9 @@
 
 #include <algorithm>
 #include <chrono>
+#include <list>
+#include <mutex>
+#include <set>
 
 #include <Base/Console.h>
 #include <Base/Exception.h>
@@ -171,7 +174,7 @@ void GeometryObject::clear()
 }
 
 //!set up a hidden line remover and project a shape with it
-void GeometryObject::projectShape(const TopoDS_Shape& input,
+bool GeometryObject::projectShape(const TopoDS_Shape& input,
                                   const gp_Ax2& viewAxis)
 {
 //    Base::Console().Message("GO::projectShape() - %s\n", m_parentName.c_str());
@@ -181,6 +184,7 @@ void GeometryObject::projectShape(const TopoDS_Shape& input,
 
     auto start = chrono::high_resolution_clock::now();
 
+    bool success = true;
     Handle(HLRBRep_Algo) brep_hlr = NULL;
     try {
         brep_hlr = new HLRBRep_Algo();
@@ -200,9 +204,11 @@ void GeometryObject::projectShape(const TopoDS_Shape& input,
     catch (const Standard_Failure& e) {
         Base::Console().Error("GO::projectShape - OCC error - %s - while projecting shape\n",
                               e.GetMessageString());
+        success = false;
         }
     catch (...) {
         Base::Console().Error("GeometryObject::projectShape - unknown error occurred while projecting shape\n");
+        success = false;
 //        throw Base::RuntimeError("GeometryObject::projectShape - unknown error occurred while projecting shape");
     }
 
@@ -262,15 +268,187 @@ void GeometryObject::projectShape(const TopoDS_Shape& input,
     catch (const Standard_Failure& e) {
         Base::Console().Error("GO::projectShape - OCC error - %s - while extracting edges\n",
                               e.GetMessageString());
+        success = false;
     }
     catch (...) {
         Base::Console().Error("GO::projectShape - unknown error while extracting edges\n");
 //        throw Base::RuntimeError("GeometryObject::projectShape - error occurred while extracting edges");
+        success = false;
     }
     end   = chrono::high_resolution_clock::now();
     diff  = end - start;
     diffOut = chrono::duration <double, milli> (diff).count();
     Base::Console().Log("TIMING - %s GO spent: %.3f millisecs in hlrToShape and BuildCurves\n",m_parentName.c_str(),diffOut);
+    return success;
+}
+
+namespace {
+
+struct CachedProjection {
+    ProjectionKey key;
+    TopoDS_Shape shapes[10];
+    std::set<const DrawPage*> pages;            //the pages using this projection
+};
+
+//most recently used first. Views of a page are projected in worker threads, so
+//the cache is guarded by a mutex.
+const std::size_t MaxCachedProjections = 32;
+std::list<CachedProjection> projectionCache;
+std::mutex projectionCacheMutex;
+
+bool isSameAxis(const gp_Ax2& a1, const gp_Ax2& a2)
+{
+    const gp_Pnt& l1 = a1.Location();
+    const gp_Pnt& l2 = a2.Location();
+    const gp_Dir& d1 = a1.Direction();
+    const gp_Dir& d2 = a2.Direction();
+    const gp_Dir& x1 = a1.XDirection();
+    const gp_Dir& x2 = a2.XDirection();
+    return l1.X() == l2.X() && l1.Y() == l2.Y() && l1.Z() == l2.Z() &&
+           d1.X() == d2.X() && d1.Y() == d2.Y() && d1.Z() == d2.Z() &&
+           x1.X() == x2.X() && x1.Y() == x2.Y() && x1.Z() == x2.Z();
+}
+
+//same TShape at the same place. Locations are compared by value, as the source
+//objects make a new one for their placement every time they are asked for a shape.
+bool isSameSource(const TopoDS_Shape& s1, const TopoDS_Shape& s2)
+{
+    if (!s1.IsPartner(s2) || s1.Orientation() != s2.Orientation()) {
+        return false;
+    }
+    gp_Trsf t1 = s1.Location().Transformation();
+    gp_Trsf t2 = s2.Location().Transformation();
+    for (int row = 1; row <= 3; row++) {
+        for (int col = 1; col <= 4; col++) {
+            if (t1.Value(row, col) != t2.Value(row, col)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}
+
+ProjectionKey::ProjectionKey() :
+    scale(1.0),
+    rotation(0.0),
+    focus(100.0),
+    isoCount(0),
+    perspective(false),
+    polygonHLR(false)
+{
+}
+
+bool ProjectionKey::operator==(const ProjectionKey& other) const
+{
+    if (scale != other.scale ||
+        rotation != other.rotation ||
+        isoCount != other.isoCount ||
+        perspective != other.perspective ||
+        polygonHLR != other.polygonHLR ||
+        (perspective && focus != other.focus) ||
+        sources.size() != other.sources.size() ||
+        !isSameAxis(viewAxis, other.viewAxis)) {
+        return false;
+    }
+    for (std::size_t i = 0; i < sources.size(); i++) {
+        if (!isSameSource(sources[i], other.sources[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GeometryObject::restoreProjection(const ProjectionKey& key, const DrawPage* page)
+{
+    if (!key.isValid()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(projectionCacheMutex);
+    for (auto it = projectionCache.begin(); it != projectionCache.end(); ++it) {
+        if (it->key == key) {
+            clear();
+            visHard    = it->shapes[0];
+            visOutline = it->shapes[1];
+            visSmooth  = it->shapes[2];
+            visSeam    = it->shapes[3];
+            visIso     = it->shapes[4];
+            hidHard    = it->shapes[5];
+            hidOutline = it->shapes[6];
+            hidSmooth  = it->shapes[7];
+            hidSeam    = it->shapes[8];
+            hidIso     = it->shapes[9];
+            if (page) {
+                it->pages.insert(page);
+            }
+            projectionCache.splice(projectionCache.begin(), projectionCache, it);
+            return true;
+        }
+    }
+    return false;
+}
+
+void GeometryObject::storeProjection(const ProjectionKey& key, const DrawPage* page) const
+{
+    if (!key.isValid()) {
+        return;
+    }
+    CachedProjection entry;
+    entry.key = key;
+    entry.shapes[0] = visHard;
+    entry.shapes[1] = visOutline;
+    entry.shapes[2] = visSmooth;
+    entry.shapes[3] = visSeam;
+    entry.shapes[4] = visIso;
+    entry.shapes[5] = hidHard;
+    entry.shapes[6] = hidOutline;
+    entry.shapes[7] = hidSmooth;
+    entry.shapes[8] = hidSeam;
+    entry.shapes[9] = hidIso;
+    if (page) {
+        entry.pages.insert(page);
+    }
+
+    std::lock_guard<std::mutex> lock(projectionCacheMutex);
+    for (auto it = projectionCache.begin(); it != projectionCache.end(); ++it) {
+        if (it->key == key) {
+            entry.pages.insert(it->pages.begin(), it->pages.end());
+            projectionCache.erase(it);
+            break;
+        }
+    }
+    projectionCache.push_front(entry);
+    if (projectionCache.size() > MaxCachedProjections) {
+        projectionCache.pop_back();
+    }
+}
+
+bool GeometryObject::hasProjection(const ProjectionKey& key)
+{
+    if (!key.isValid()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(projectionCacheMutex);
+    for (auto& entry: projectionCache) {
+        if (entry.key == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void GeometryObject::clearProjectionCache(const DrawPage* page)
+{
+    std::lock_guard<std::mutex> lock(projectionCacheMutex);
+    for (auto it = projectionCache.begin(); it != projectionCache.end(); ) {
+        it->pages.erase(page);
+        if (it->pages.empty()) {
+            it = projectionCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 //mirror a shape thru XZ plane for Qt's inverted Y coordinate
@@ -294,7 +472,7 @@ TopoDS_Shape GeometryObject::invertGeometry(const TopoDS_Shape s)
 }
 
 //!set up a hidden line remover and project a shape with it
-void GeometryObject::projectShapeWithPolygonAlgo(const TopoDS_Shape& input,
+bool GeometryObject::projectShapeWithPolygonAlgo(const TopoDS_Shape& input,
                                                  const gp_Ax2 &viewAxis)
 {
     // Clear previous Geometry
@@ -316,16 +494,15 @@ void GeometryObject::projectShapeWithPolygonAlgo(const TopoDS_Shape& input,
 
     auto start = chrono::high_resolution_clock::now();
 
+    bool success = true;
     Handle(HLRBRep_PolyAlgo) brep_hlrPoly = NULL;
 
     try {
-        TopExp_Explorer faces(inCopy, TopAbs_FACE);
-        for (int i = 1; faces.More(); faces.Next(), i++) {
-            const TopoDS_Face& f = TopoDS::Face(faces.Current());
-            if (!f.IsNull()) {
-                BRepMesh_IncrementalMesh(f, 0.10); //Poly Algo requires a mesh!
-            }
-        }
+        //Poly Algo requires a mesh! mesh all faces at once so OCC can do them in parallel
+        BRepMesh_IncrementalMesh(inCopy, 0.10,
+                                 /*isRelative*/ Standard_False,
+                                 /*theAngDeflection*/ 0.5,
+                                 /*isInParallel*/ Standard_True);
         brep_hlrPoly = new HLRBRep_PolyAlgo();
         brep_hlrPoly->Load(inCopy);
 
@@ -343,9 +520,11 @@ void GeometryObject::projectShapeWithPolygonAlgo(const TopoDS_Shape& input,
     catch (const Standard_Failure& e) {
         Base::Console().Error("GO::projectShapeWithPolygonAlgo - OCC error - %s - while projecting shape\n",
                               e.GetMessageString());
+        success = false;
     }
     catch (...) {
         Base::Console().Error("GO::projectShapeWithPolygonAlgo - unknown error while projecting shape\n");
+        success = false;
 //        throw Base::RuntimeError("GeometryObject::projectShapeWithPolygonAlgo  - error occurred while projecting shape");
 //        Standard_Failure::Raise("GeometryObject::projectShapeWithPolygonAlgo  - error occurred while projecting shape");
     }
@@ -391,9 +570,11 @@ void GeometryObject::projectShapeWithPolygonAlgo(const TopoDS_Shape& input,
     catch (const Standard_Failure& e) {
         Base::Console().Error("GO::projectShapeWithPolygonAlgo - OCC error - %s - while extracting edges\n",
                               e.GetMessageString());
+        success = false;
     }
     catch (...) {
         Base::Console().Error("GO::projectShapeWithPolygonAlgo - - error occurred while extracting edges\n");
+        success = false;
 //        throw Base::RuntimeError("GeometryObject::projectShapeWithPolygonAlgo  - error occurred while extracting edges");
 //        Standard_Failure::Raise("GeometryObject::projectShapeWithPolygonAlgo - error occurred while extracting edges");
     }
@@ -401,6 +582,7 @@ void GeometryObject::projectShapeWithPolygonAlgo(const TopoDS_Shape& input,
     auto diff = end - start;
     double diffOut = chrono::duration <double, milli>(diff).count();
     Base::Console().Log("TIMING - %s GO spent: %.3f millisecs in HLRBRep_PolyAlgo & co\n", m_parentName.c_str(), diffOut);
+    return success;
 }
 
 TopoDS_Shape GeometryObject::projectFace(const TopoDS_Shape &face,
@@ -41,6 +41,7 @@ namespace TechDraw
 class DrawViewPart;
 class DrawViewDetail;
 class DrawView;
+class DrawPage;
 class CosmeticVertex;
 class CosmeticEdge;
 }
@@ -92,6 +93,26 @@ gp_Ax2 TechDrawExport legacyViewAxis1(const Base::Vector3d origin,
                                      const Base::Vector3d& direction,
                                      const bool flip=true);
 
+//! everything the HLR output of a view depends on. Views with equal keys get
+//! the same projection, so it only has to be computed once.
+class TechDrawExport ProjectionKey
+{
+public:
+    ProjectionKey();
+
+    bool isValid() const { return !sources.empty(); }
+    bool operator==(const ProjectionKey& other) const;
+
+    std::vector<TopoDS_Shape> sources;          //the (uncopied) shapes of the source objects
+    gp_Ax2 viewAxis;
+    double scale;
+    double rotation;
+    double focus;
+    int isoCount;
+    bool perspective;
+    bool polygonHLR;
+};
+
 class TechDrawExport GeometryObject
 {
 public:
@@ -112,13 +133,24 @@ public:
     void setVertexGeometry(std::vector<Vertex*> newVerts) {vertexGeom = newVerts; }
     void setEdgeGeometry(std::vector<BaseGeom*> newGeoms) {edgeGeom = newGeoms; }
 
-    void projectShape(const TopoDS_Shape &input,
+    //! returns false if the hidden line removal failed
+    bool projectShape(const TopoDS_Shape &input,
                       const gp_Ax2 &viewAxis);
-    void projectShapeWithPolygonAlgo(const TopoDS_Shape &input,
+    bool projectShapeWithPolygonAlgo(const TopoDS_Shape &input,
                                      const gp_Ax2 &viewAxis);
     TopoDS_Shape projectFace(const TopoDS_Shape &face,
                              const gp_Ax2 &CS);
 
+    //! take the HLR output from the projection cache. Returns false if key is not cached.
+    //! page is added to the users of the cached projection.
+    bool restoreProjection(const ProjectionKey& key, const DrawPage* page);
+    //! put the HLR output of this object into the projection cache on behalf of page
+    void storeProjection(const ProjectionKey& key, const DrawPage* page) const;
+    static bool hasProjection(const ProjectionKey& key);
+    //! drop page from the users of the cached projections. Projections without
+    //! users left are removed.
+    static void clearProjectionCache(const DrawPage* page);
+
     void extractGeometry(edgeClass category, bool visible);
     void addFaceGeom(Face * f);
     void clearFaceGeom();
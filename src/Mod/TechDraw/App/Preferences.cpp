@@ -148,6 +148,26 @@ bool Preferences::keepPagesUpToDate()
     return autoUpdate;
 }
 
+//project the views of a page in worker threads
+bool Preferences::concurrentViews()
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter().
+                                         GetGroup("BaseApp")->GetGroup("Preferences")->
+                                         GetGroup("Mod/TechDraw/General");
+    bool concurrent = hGrp->GetBool("ConcurrentViews", true);
+    return concurrent;
+}
+
+//show polygonal projections first and exact ones once they are computed
+bool Preferences::draftProjection()
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter().
+                                         GetGroup("BaseApp")->GetGroup("Preferences")->
+                                         GetGroup("Mod/TechDraw/General");
+    bool draft = hGrp->GetBool("DraftProjection", false);
+    return draft;
+}
+
 bool Preferences::useGlobalDecimals()
 {
     bool result = false;
@@ -57,6 +57,8 @@ static double      vertexScale();
 
 static bool        useGlobalDecimals();
 static bool        keepPagesUpToDate();
+static bool        concurrentViews();
+static bool        draftProjection();
 
 static int         projectionAngle();
 static std::string lineGroup();